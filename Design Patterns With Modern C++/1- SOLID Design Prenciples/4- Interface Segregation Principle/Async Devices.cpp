@@ -0,0 +1,480 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Awaitable device operations: the "Printable", "Scannable" and "Faxable" interfaces from "main.cpp" are blocking "void" calls,
+ *        so a program that talks to many devices can only wait on one of them at a time.
+ *        Here every interface gets an asynchronous twin ("print_async()", "scan_async()", "fax_async()") written as a C++20 coroutine,
+ *        so we can write "co_await printer.print_async(job)" and thousands of operations stay in flight on a single thread.
+ *
+ *        Build: g++ -std=c++20 -O2 -pthread "Async Devices.cpp" -o AsyncDevices
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <deque>
+#include <queue>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <optional>
+#include <exception>
+#include <coroutine>
+#include <condition_variable>
+
+/**
+ * \brief The building blocks:
+ *
+ *        - Task<T>     : a lazily started coroutine. It starts running only when somebody "co_await"s it, and when it finishes it resumes
+ *                        whoever was waiting for it (no threads involved).
+ *        - EventLoop   : a single-threaded scheduler. It owns a ready queue and a timer queue, so "waiting" for a device is just
+ *                        parking a coroutine handle until its deadline, not blocking a thread.
+ *        - ThreadPool  : optional. A coroutine can hop onto it with "co_await pool.schedule()" for CPU-heavy work (e.g. rendering a page)
+ *                        and hop back with "co_await loop.resumeOnLoop()".
+*/
+
+
+//Example:
+//=========
+
+using Clock = std::chrono::steady_clock;
+
+// Storage for the result of a Task<T>, specialized for "void" so both can share one promise.
+template <typename T>
+struct TaskResult {
+    std::optional<T> value;
+    void return_value(T v) { value = std::move(v); }
+    T take() { return std::move(*value); }
+};
+
+template <>
+struct TaskResult<void> {
+    void return_void() {}
+    void take() {}
+};
+
+// Lazily started coroutine that resumes its awaiter when it completes.
+template <typename T = void>
+class Task {
+public:
+    struct promise_type : TaskResult<T> {
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+        std::exception_ptr error;
+
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                return h.promise().continuation; // Symmetric transfer back to the awaiter
+            }
+            void await_resume() noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { if (handle_) handle_.destroy(); }
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle_.promise().continuation = awaiting;
+        return handle_; // Start the task now that somebody waits for it
+    }
+
+    T await_resume() {
+        if (handle_.promise().error) std::rethrow_exception(handle_.promise().error);
+        return handle_.promise().take();
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> h) : handle_(h) {}
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// Fire-and-forget coroutine used by EventLoop::spawn(), it frees itself when it finishes.
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// Single-threaded event loop: every coroutine it owns is resumed on the thread calling run().
+class EventLoop {
+public:
+    // Thread-safe: queue a coroutine to be resumed on the loop thread.
+    void post(std::coroutine_handle<> h) {
+        {
+            std::lock_guard<std::mutex> lock(remoteMutex_);
+            remote_.push_back(h);
+        }
+        remoteCv_.notify_one();
+    }
+
+    // Hop back onto the loop thread (no-op if we are already there).
+    auto resumeOnLoop() {
+        struct Awaiter {
+            EventLoop& loop;
+            bool await_ready() const noexcept { return std::this_thread::get_id() == loop.loopThread_.load(std::memory_order_acquire); }
+            void await_suspend(std::coroutine_handle<> h) { loop.post(h); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+    // Loop thread only: suspend the calling coroutine until "delay" has passed.
+    auto sleepFor(Clock::duration delay) {
+        struct Awaiter {
+            EventLoop& loop;
+            Clock::time_point deadline;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { loop.timers_.push(Timer{deadline, h}); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this, Clock::now() + delay};
+    }
+
+    // Start a task on the loop; run() returns once every spawned task finished.
+    void spawn(Task<void> task) {
+        live_.fetch_add(1, std::memory_order_relaxed);
+        runDetached(std::move(task));
+    }
+
+    void run() {
+        loopThread_.store(std::this_thread::get_id(), std::memory_order_release);
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(remoteMutex_);
+                for (auto h : remote_) ready_.push_back(h);
+                remote_.clear();
+            }
+
+            const auto now = Clock::now();
+            while (!timers_.empty() && timers_.top().deadline <= now) {
+                ready_.push_back(timers_.top().handle);
+                timers_.pop();
+            }
+
+            if (ready_.empty()) {
+                if (live_.load(std::memory_order_acquire) == 0) break;
+
+                std::unique_lock<std::mutex> lock(remoteMutex_);
+                auto hasRemote = [this] { return !remote_.empty(); };
+                if (timers_.empty()) remoteCv_.wait(lock, hasRemote);
+                else remoteCv_.wait_until(lock, timers_.top().deadline, hasRemote);
+                continue;
+            }
+
+            while (!ready_.empty()) {
+                auto h = ready_.front();
+                ready_.pop_front();
+                h.resume();
+            }
+        }
+        loopThread_.store(std::thread::id(), std::memory_order_release);
+    }
+
+private:
+    struct Timer {
+        Clock::time_point deadline;
+        std::coroutine_handle<> handle;
+        bool operator>(const Timer& other) const { return deadline > other.deadline; }
+    };
+
+    auto yield() {
+        struct Awaiter {
+            EventLoop& loop;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { loop.post(h); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+    Detached runDetached(Task<void> task) {
+        co_await yield();        // Start on the loop rather than inside spawn()
+        co_await task;
+        co_await resumeOnLoop(); // Tasks may end on a pool thread, finish bookkeeping on the loop
+        live_.fetch_sub(1, std::memory_order_release);
+    }
+
+    std::deque<std::coroutine_handle<>> ready_;                                          // Loop thread only
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;          // Loop thread only
+    std::mutex remoteMutex_;
+    std::condition_variable remoteCv_;
+    std::vector<std::coroutine_handle<>> remote_;
+    std::atomic<std::size_t> live_{0};
+    std::atomic<std::thread::id> loopThread_{};                                          // Read by resumeOnLoop() on any thread
+};
+
+// Optional pool for CPU-bound steps, coroutines hop onto it and back to the loop.
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t threads) {
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+
+    auto schedule() {
+        struct Awaiter {
+            ThreadPool& pool;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) {
+                {
+                    std::lock_guard<std::mutex> lock(pool.mutex_);
+                    pool.queue_.push_back(h);
+                }
+                pool.cv_.notify_one();
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+private:
+    void work() {
+        for (;;) {
+            std::coroutine_handle<> h;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                if (stop_ && queue_.empty()) return;
+                h = queue_.front();
+                queue_.pop_front();
+            }
+            h.resume();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::deque<std::coroutine_handle<>> queue_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+};
+
+
+// A unit of work handed to a device.
+struct DeviceJob {
+    int id;
+    std::size_t pages;
+};
+
+// Asynchronous interfaces, segregated exactly like their blocking counterparts in "main.cpp".
+class AsyncPrintable {
+public:
+    virtual Task<std::size_t> print_async(DeviceJob job) = 0;  // Returns the number of printed pages
+    virtual ~AsyncPrintable() = default;
+};
+
+class AsyncScannable {
+public:
+    virtual Task<std::size_t> scan_async(DeviceJob job) = 0;   // Returns the number of scanned pages
+    virtual ~AsyncScannable() = default;
+};
+
+class AsyncFaxable {
+public:
+    virtual Task<std::size_t> fax_async(DeviceJob job) = 0;    // Returns the number of faxed pages
+    virtual ~AsyncFaxable() = default;
+};
+
+// Local stand-in for real hardware: each page costs "perPage" of latency on the loop,
+// plus an optional CPU-bound "render" step on the pool.
+class SimulatedDevice {
+public:
+    SimulatedDevice(EventLoop& loop, Clock::duration perPage, ThreadPool* pool = nullptr)
+        : loop_(loop), perPage_(perPage), pool_(pool) {}
+
+protected:
+    Task<void> simulate(std::size_t pages) {
+        if (pool_) {
+            co_await pool_->schedule();
+            render(pages);
+            co_await loop_.resumeOnLoop();
+        }
+        co_await loop_.sleepFor(perPage_ * static_cast<long>(pages));
+    }
+
+private:
+    static void render(std::size_t pages) {
+        volatile std::size_t checksum = 0;
+        for (std::size_t i = 0; i < pages * 1000; ++i) checksum = checksum + i;
+    }
+
+    EventLoop& loop_;
+    Clock::duration perPage_;
+    ThreadPool* pool_;
+};
+
+class AsyncPrinter : public AsyncPrintable, private SimulatedDevice {
+public:
+    using SimulatedDevice::SimulatedDevice;
+
+    Task<std::size_t> print_async(DeviceJob job) override {
+        co_await simulate(job.pages);
+        co_return job.pages;
+    }
+};
+
+class AsyncScanner : public AsyncScannable, private SimulatedDevice {
+public:
+    using SimulatedDevice::SimulatedDevice;
+
+    Task<std::size_t> scan_async(DeviceJob job) override {
+        co_await simulate(job.pages);
+        co_return job.pages;
+    }
+};
+
+class AsyncFax : public AsyncFaxable, private SimulatedDevice {
+public:
+    using SimulatedDevice::SimulatedDevice;
+
+    Task<std::size_t> fax_async(DeviceJob job) override {
+        co_await simulate(job.pages);
+        co_return job.pages;
+    }
+};
+
+// Same idea as "PrinterScanner" in "main.cpp": a combined device only implements what it needs.
+class AsyncPrinterScanner : public AsyncPrintable, public AsyncScannable, private SimulatedDevice {
+public:
+    using SimulatedDevice::SimulatedDevice;
+
+    Task<std::size_t> print_async(DeviceJob job) override {
+        co_await simulate(job.pages);
+        co_return job.pages;
+    }
+
+    Task<std::size_t> scan_async(DeviceJob job) override {
+        co_await simulate(job.pages);
+        co_return job.pages;
+    }
+};
+
+
+// A client coroutine: scan a document and then print it, other clients run while this one waits.
+Task<void> copyDocument(AsyncScannable& scanner, AsyncPrintable& printer, DeviceJob job, std::size_t& pagesDone) {
+    std::size_t scanned = co_await scanner.scan_async(job);
+    std::size_t printed = co_await printer.print_async(DeviceJob{job.id, scanned});
+    pagesDone += printed;
+}
+
+Task<void> printMany(AsyncPrintable& printer, int jobs, std::size_t& pagesDone) {
+    for (int i = 0; i < jobs; ++i) {
+        pagesDone += co_await printer.print_async(DeviceJob{i, 1});
+    }
+}
+
+int main() {
+    using namespace std::chrono;
+    const auto perPage = milliseconds(2);
+
+    // 1) A small demo: scan-then-print on a combined device and on separate devices at the same time.
+    {
+        EventLoop loop;
+        AsyncScanner scanner(loop, perPage);
+        AsyncPrinter printer(loop, perPage);
+        AsyncPrinterScanner dualMachine(loop, perPage);
+        std::size_t pages = 0;
+
+        loop.spawn(copyDocument(scanner, printer, DeviceJob{1, 3}, pages));
+        loop.spawn(copyDocument(dualMachine, dualMachine, DeviceJob{2, 3}, pages));
+        loop.run();
+
+        std::cout << "Copied pages: " << pages << std::endl; // Output: Copied pages: 6
+    }
+
+    // 2) Benchmark: thousands of in-flight operations on one thread vs. blocking calls.
+    const int devices = 2000;
+    const int jobsPerDevice = 5;
+
+    {
+        EventLoop loop;
+        std::vector<std::unique_ptr<AsyncPrinter>> printers;
+        std::size_t pages = 0;
+        for (int i = 0; i < devices; ++i) {
+            printers.push_back(std::make_unique<AsyncPrinter>(loop, perPage));
+        }
+
+        auto start = steady_clock::now();
+        for (auto& p : printers) loop.spawn(printMany(*p, jobsPerDevice, pages));
+        loop.run();
+        auto elapsed = duration<double>(steady_clock::now() - start).count();
+
+        std::cout << "Event loop : " << pages << " ops on " << devices << " devices in " << elapsed << " s ("
+                  << pages / elapsed << " ops/s)" << std::endl;
+    }
+
+    {
+        EventLoop loop;
+        ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<std::unique_ptr<AsyncPrinter>> printers;
+        std::size_t pages = 0;
+        for (int i = 0; i < devices; ++i) {
+            printers.push_back(std::make_unique<AsyncPrinter>(loop, perPage, &pool));
+        }
+
+        auto start = steady_clock::now();
+        for (auto& p : printers) loop.spawn(printMany(*p, jobsPerDevice, pages));
+        loop.run();
+        auto elapsed = duration<double>(steady_clock::now() - start).count();
+
+        std::cout << "Loop + pool: " << pages << " ops on " << devices << " devices in " << elapsed << " s ("
+                  << pages / elapsed << " ops/s)" << std::endl;
+    }
+
+    {
+        const int blockingOps = 200; // Blocking calls are serialized, so keep the sample small
+        auto start = steady_clock::now();
+        for (int i = 0; i < blockingOps; ++i) std::this_thread::sleep_for(perPage);
+        auto elapsed = duration<double>(steady_clock::now() - start).count();
+
+        std::cout << "Blocking   : " << blockingOps << " ops in " << elapsed << " s ("
+                  << blockingOps / elapsed << " ops/s)" << std::endl;
+    }
+
+    getchar();
+    return 0;
+}
+
+
+/**
+ * \brief   Note that the event loop never creates a thread per device: a waiting device is only a coroutine handle sitting in the timer queue,
+ *          which is why the number of in-flight operations is limited by memory and not by the number of threads.
+ *
+ *          Note: "sleepFor()" must be awaited on the loop thread, that is why "SimulatedDevice::simulate()" hops back with "resumeOnLoop()"
+ *                after it finishes its work on the thread pool.
+*/
@@ -0,0 +1,327 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Device pool: when several identical devices (e.g. a few "Printer"s) serve the same queue, handing job N to device N % count
+ *        (round-robin) leaves some devices idle while others are stuck behind one huge job.
+ *        Here every device of the pool owns a local deque of jobs, and a device that runs out of work steals queued jobs from the
+ *        others. Submitters are admitted through a bounded counter, so when too many jobs are in flight "submit()" waits (backpressure)
+ *        and "trySubmit()" refuses the job.
+ *
+ *        Build: g++ -std=c++20 -O2 -pthread "Device Pool.cpp" -o DevicePool
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <memory>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <semaphore>
+#include <condition_variable>
+
+/**
+ * \brief The pool does not care which device interface it drives: it is a template over the device type plus an "operation"
+ *        that calls the right method (print(), scan() or fax()), so printers, scanners and faxes keep their segregated interfaces
+ *        and still share one pooling implementation.
+*/
+
+
+//Example:
+//=========
+
+using Clock = std::chrono::steady_clock;
+
+// A unit of work handed to a device.
+struct DeviceJob {
+    int id = 0;
+    std::size_t pages = 1;
+    Clock::time_point submitted{};
+};
+
+// Job-aware versions of the segregated device interfaces.
+class Printable {
+public:
+    virtual void print(const DeviceJob& job) = 0;
+    virtual ~Printable() = default;
+};
+
+class Scannable {
+public:
+    virtual void scan(const DeviceJob& job) = 0;
+    virtual ~Scannable() = default;
+};
+
+class Faxable {
+public:
+    virtual void fax(const DeviceJob& job) = 0;
+    virtual ~Faxable() = default;
+};
+
+enum class DispatchPolicy {
+    RoundRobin,    // A job stays on the device it was assigned to
+    WorkStealing   // Idle devices steal queued jobs from busy ones
+};
+
+template <typename Device>
+class DevicePool {
+public:
+    using Operation = std::function<void(Device&, const DeviceJob&)>;
+
+    DevicePool(std::vector<Device*> devices, Operation operation, std::size_t maxInFlight,
+               DispatchPolicy policy = DispatchPolicy::WorkStealing)
+        : operation_(std::move(operation)), policy_(policy), admission_(static_cast<std::ptrdiff_t>(maxInFlight)) {
+        for (Device* device : devices) workers_.push_back(std::make_unique<Worker>(device));
+        for (std::size_t i = 0; i < workers_.size(); ++i) {
+            workers_[i]->thread = std::thread([this, i] { run(i); });
+        }
+    }
+
+    ~DevicePool() {
+        waitIdle();
+        {
+            std::lock_guard<std::mutex> lock(idleMutex_);
+            stop_ = true;
+        }
+        idleCv_.notify_all();
+        for (auto& w : workers_) w->thread.join();
+    }
+
+    // Blocks while "maxInFlight" jobs are already queued or running.
+    void submit(DeviceJob job) {
+        job.submitted = Clock::now();
+        admission_.acquire();
+        enqueue(std::move(job));
+    }
+
+    // Refuses the job instead of waiting when the pool is saturated.
+    bool trySubmit(DeviceJob job) {
+        job.submitted = Clock::now();
+        if (!admission_.try_acquire()) return false;
+        enqueue(std::move(job));
+        return true;
+    }
+
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(idleMutex_);
+        doneCv_.wait(lock, [this] { return inFlight_ == 0; });
+    }
+
+    // Submit-to-completion latencies of all finished jobs (call after waitIdle()).
+    std::vector<Clock::duration> latencies() const {
+        std::vector<Clock::duration> all;
+        for (const auto& w : workers_) all.insert(all.end(), w->latencies.begin(), w->latencies.end());
+        return all;
+    }
+
+    std::size_t steals() const { return steals_.load(std::memory_order_relaxed); }
+
+private:
+    struct Worker {
+        explicit Worker(Device* d) : device(d) {}
+        Device* device;
+        std::mutex mutex;
+        std::deque<DeviceJob> jobs;
+        std::atomic<std::size_t> pending{0};
+        std::vector<Clock::duration> latencies;   // Touched by the owning thread only
+        std::thread thread;
+    };
+
+    void enqueue(DeviceJob job) {
+        Worker& target = *workers_[nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size()];
+        {
+            std::lock_guard<std::mutex> lock(target.mutex);
+            target.jobs.push_back(std::move(job));
+            target.pending.fetch_add(1, std::memory_order_relaxed);
+        }
+        {
+            std::lock_guard<std::mutex> lock(idleMutex_);
+            ++inFlight_;
+            ++queued_;
+        }
+        // Round-robin must wake the owner, any idle device will do when stealing is allowed.
+        if (policy_ == DispatchPolicy::WorkStealing) idleCv_.notify_one();
+        else idleCv_.notify_all();
+    }
+
+    // The owner takes the oldest job of its own deque.
+    std::optional<DeviceJob> popLocal(Worker& w) {
+        std::lock_guard<std::mutex> lock(w.mutex);
+        if (w.jobs.empty()) return std::nullopt;
+        DeviceJob job = std::move(w.jobs.front());
+        w.jobs.pop_front();
+        w.pending.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    // A thief takes the newest job from the back of the busiest victim, away from its owner's end.
+    std::optional<DeviceJob> steal(std::size_t self) {
+        std::size_t victim = self;
+        std::size_t most = 0;
+        for (std::size_t i = 0; i < workers_.size(); ++i) {
+            std::size_t pending = workers_[i]->pending.load(std::memory_order_relaxed);
+            if (i != self && pending > most) {
+                most = pending;
+                victim = i;
+            }
+        }
+        if (victim == self) return std::nullopt;
+
+        Worker& w = *workers_[victim];
+        std::lock_guard<std::mutex> lock(w.mutex);
+        if (w.jobs.empty()) return std::nullopt;
+        DeviceJob job = std::move(w.jobs.back());
+        w.jobs.pop_back();
+        w.pending.fetch_sub(1, std::memory_order_relaxed);
+        steals_.fetch_add(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    void run(std::size_t self) {
+        Worker& me = *workers_[self];
+        for (;;) {
+            std::optional<DeviceJob> job = popLocal(me);
+            if (!job && policy_ == DispatchPolicy::WorkStealing) job = steal(self);
+
+            if (!job) {
+                std::unique_lock<std::mutex> lock(idleMutex_);
+                idleCv_.wait(lock, [&] {
+                    if (stop_) return true;
+                    return policy_ == DispatchPolicy::WorkStealing ? queued_ > 0
+                                                                    : me.pending.load(std::memory_order_relaxed) > 0;
+                });
+                if (stop_) return;
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(idleMutex_);
+                --queued_;
+            }
+
+            operation_(*me.device, *job);
+            me.latencies.push_back(Clock::now() - job->submitted);
+            admission_.release();
+
+            bool idle = false;
+            {
+                std::lock_guard<std::mutex> lock(idleMutex_);
+                idle = --inFlight_ == 0;
+            }
+            if (idle) doneCv_.notify_all();
+        }
+    }
+
+    Operation operation_;
+    DispatchPolicy policy_;
+    std::counting_semaphore<> admission_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<std::size_t> nextWorker_{0};
+    std::atomic<std::size_t> steals_{0};
+
+    std::mutex idleMutex_;
+    std::condition_variable idleCv_;
+    std::condition_variable doneCv_;
+    std::size_t queued_ = 0;     // Jobs sitting in any deque
+    std::size_t inFlight_ = 0;   // Jobs queued or running
+    bool stop_ = false;
+};
+
+
+// Simulated printer: every page costs a fixed amount of device time.
+class SimulatedPrinter : public Printable {
+public:
+    explicit SimulatedPrinter(Clock::duration perPage) : perPage_(perPage) {}
+
+    void print(const DeviceJob& job) override {
+        std::this_thread::sleep_for(perPage_ * static_cast<long>(job.pages));
+    }
+
+private:
+    Clock::duration perPage_;
+};
+
+struct LatencyReport {
+    double p50, p99, max;   // Milliseconds
+    double seconds;
+    std::size_t steals;
+};
+
+static LatencyReport runSkewedLoad(DispatchPolicy policy, std::size_t deviceCount, int jobs) {
+    using namespace std::chrono;
+    std::vector<std::unique_ptr<SimulatedPrinter>> printers;
+    std::vector<Printable*> devices;
+    for (std::size_t i = 0; i < deviceCount; ++i) {
+        printers.push_back(std::make_unique<SimulatedPrinter>(microseconds(200)));
+        devices.push_back(printers.back().get());
+    }
+
+    std::mt19937 rng(42); // Same job sequence for both policies
+    std::bernoulli_distribution bigJob(0.05);
+
+    auto start = steady_clock::now();
+    std::vector<Clock::duration> latencies;
+    std::size_t steals = 0;
+    {
+        DevicePool<Printable> pool(devices, [](Printable& p, const DeviceJob& job) { p.print(job); }, 64, policy);
+        for (int i = 0; i < jobs; ++i) {
+            pool.submit(DeviceJob{i, bigJob(rng) ? std::size_t{40} : std::size_t{1}});
+            std::this_thread::sleep_for(microseconds(150));
+        }
+        pool.waitIdle();
+        latencies = pool.latencies();
+        steals = pool.steals();
+    }
+    double seconds = duration<double>(steady_clock::now() - start).count();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto ms = [](Clock::duration d) { return duration<double, std::milli>(d).count(); };
+    auto at = [&](double q) { return ms(latencies[static_cast<std::size_t>(q * (latencies.size() - 1))]); };
+    return {at(0.50), at(0.99), ms(latencies.back()), seconds, steals};
+}
+
+int main() {
+    const std::size_t devices = 8;
+    const int jobs = 4000;
+
+    for (DispatchPolicy policy : {DispatchPolicy::RoundRobin, DispatchPolicy::WorkStealing}) {
+        LatencyReport r = runSkewedLoad(policy, devices, jobs);
+        std::cout << (policy == DispatchPolicy::RoundRobin ? "Round-robin  " : "Work-stealing")
+                  << ": p50 = " << r.p50 << " ms, p99 = " << r.p99 << " ms, max = " << r.max
+                  << " ms, total = " << r.seconds << " s, steals = " << r.steals << std::endl;
+    }
+
+    // Bounded admission: with one slot in flight, the second "trySubmit()" is refused instead of queued.
+    {
+        SimulatedPrinter printer(std::chrono::milliseconds(20));
+        DevicePool<Printable> pool({&printer}, [](Printable& p, const DeviceJob& job) { p.print(job); }, 1);
+        bool first = pool.trySubmit(DeviceJob{1, 1});
+        bool second = pool.trySubmit(DeviceJob{2, 1});
+        std::cout << "trySubmit: first = " << first << ", second = " << second << std::endl; // Output: first = 1, second = 0
+    }
+
+    getchar();
+    return 0;
+}
+
+
+/**
+ * \brief   Note that with round-robin a 40-page job blocks every 1-page job that was assigned behind it on the same device,
+ *          which is exactly what shows up in the p99 latency, with work stealing those small jobs are taken by idle devices.
+ *
+ *          Note: the deques here are protected by a small mutex per device, which is plenty for device-sized jobs (milliseconds),
+ *                a lock-free deque only pays off when the jobs themselves take a few microseconds.
+*/
@@ -0,0 +1,473 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Zero-copy page pipeline: in "main.cpp" nothing connects the output of a scanner to the input of a fax or a printer,
+ *        so in practice every stage copies the page buffer it received into the next one.
+ *        Here a scanner writes each page directly into a slot of a pre-allocated ring, and the fax (or printer) reads the very same
+ *        slot in place. When all slots are full the scanner waits (backpressure) instead of allocating more memory.
+ *
+ *        Build: g++ -std=c++20 -O2 -pthread "Scan To Fax Pipeline.cpp" -o ScanToFaxPipeline
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <queue>
+#include <span>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <condition_variable>
+
+/**
+ * \brief Two rings with the same "lease" API are provided:
+ *
+ *        - SpscPageRing : one producer and one consumer, no compare-and-swap at all, just a head and a tail counter.
+ *        - MpmcPageRing : any number of producers and consumers (a bounded queue with a sequence number per slot),
+ *                         used when several fax lines drain the pages of one scanner.
+ *
+ *        A stage calls "acquireWrite()" to get a writable span into a free slot and "commit(size)" when the page is ready,
+ *        or "acquireRead()" to get a read-only span into a filled slot, the slot goes back to the producer when the ReadLease dies.
+*/
+
+
+//Example:
+//=========
+
+// Interfaces for page-oriented devices, each client only implements what it needs (ISP).
+class PageScannable {
+public:
+    virtual std::size_t scanPage(std::span<std::byte> out) = 0;        // Writes one page into "out", returns its size in bytes
+    virtual ~PageScannable() = default;
+};
+
+class PageFaxable {
+public:
+    virtual void faxPage(std::span<const std::byte> page) = 0;         // Sends one page without taking ownership of it
+    virtual ~PageFaxable() = default;
+};
+
+class PagePrintable {
+public:
+    virtual void printPage(std::span<const std::byte> page) = 0;       // Prints one page without taking ownership of it
+    virtual ~PagePrintable() = default;
+};
+
+
+// RAII handles over a ring slot, shared by both ring types.
+template <typename Ring>
+class WriteLease {
+public:
+    WriteLease(Ring& ring, std::uint64_t pos, std::span<std::byte> buffer) : ring_(&ring), pos_(pos), buffer_(buffer) {}
+    WriteLease(WriteLease&& other) noexcept
+        : ring_(std::exchange(other.ring_, nullptr)), pos_(other.pos_), buffer_(other.buffer_) {}
+    ~WriteLease() { if (ring_) commit(0); } // An abandoned slot is published as an empty page
+
+    std::span<std::byte> buffer() const { return buffer_; }
+
+    void commit(std::size_t size) {
+        std::exchange(ring_, nullptr)->commitWrite(pos_, size);
+    }
+
+private:
+    Ring* ring_;
+    std::uint64_t pos_;
+    std::span<std::byte> buffer_;
+};
+
+template <typename Ring>
+class ReadLease {
+public:
+    ReadLease() = default; // End of stream
+    ReadLease(Ring& ring, std::uint64_t pos, std::span<const std::byte> page) : ring_(&ring), pos_(pos), page_(page) {}
+    ReadLease(ReadLease&& other) noexcept
+        : ring_(std::exchange(other.ring_, nullptr)), pos_(other.pos_), page_(other.page_) {}
+    ~ReadLease() { if (ring_) ring_->releaseRead(pos_); }
+
+    explicit operator bool() const { return ring_ != nullptr; }
+    std::span<const std::byte> page() const { return page_; }
+
+private:
+    Ring* ring_ = nullptr;
+    std::uint64_t pos_ = 0;
+    std::span<const std::byte> page_;
+};
+
+
+// Single-producer / single-consumer ring of fixed-size page slots.
+class SpscPageRing {
+public:
+    SpscPageRing(std::size_t slots, std::size_t pageBytes)
+        : slots_(slots), pageBytes_(pageBytes), storage_(new std::byte[slots * pageBytes]), sizes_(slots) {}
+
+    WriteLease<SpscPageRing> acquireWrite() {
+        const std::uint64_t head = head_.load(std::memory_order_relaxed) & ~kClosed;
+        std::uint64_t tail = tail_.load(std::memory_order_acquire);
+        while (head - tail == slots_) { // Full: wait for the consumer (backpressure)
+            stalls_.fetch_add(1, std::memory_order_relaxed);
+            tail_.wait(tail, std::memory_order_acquire);
+            tail = tail_.load(std::memory_order_acquire);
+        }
+        return {*this, head, slot(head)};
+    }
+
+    ReadLease<SpscPageRing> acquireRead() {
+        const std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        std::uint64_t head = head_.load(std::memory_order_acquire);
+        while ((head & ~kClosed) == tail) { // Empty: wait for the producer
+            if (head & kClosed) return {};
+            head_.wait(head, std::memory_order_acquire);
+            head = head_.load(std::memory_order_acquire);
+        }
+        const std::size_t index = tail % slots_;
+        return {*this, tail, std::span<const std::byte>(slot(tail).data(), sizes_[index])};
+    }
+
+    // Called by the producer after its last commit.
+    void close() {
+        head_.fetch_or(kClosed, std::memory_order_release);
+        head_.notify_all();
+    }
+
+    std::size_t stalls() const { return stalls_.load(std::memory_order_relaxed); }
+
+private:
+    friend class WriteLease<SpscPageRing>;
+    friend class ReadLease<SpscPageRing>;
+
+    static constexpr std::uint64_t kClosed = 1ull << 63;
+
+    std::span<std::byte> slot(std::uint64_t pos) const {
+        return {storage_.get() + (pos % slots_) * pageBytes_, pageBytes_};
+    }
+
+    void commitWrite(std::uint64_t pos, std::size_t size) {
+        sizes_[pos % slots_] = size;
+        head_.store(pos + 1, std::memory_order_release);
+        head_.notify_one();
+    }
+
+    void releaseRead(std::uint64_t pos) {
+        tail_.store(pos + 1, std::memory_order_release);
+        tail_.notify_one();
+    }
+
+    const std::size_t slots_;
+    const std::size_t pageBytes_;
+    std::unique_ptr<std::byte[]> storage_;
+    std::vector<std::size_t> sizes_;
+    alignas(64) std::atomic<std::uint64_t> head_{0};   // Next slot to write, the top bit marks "closed"
+    alignas(64) std::atomic<std::uint64_t> tail_{0};   // Next slot to read
+    alignas(64) std::atomic<std::size_t> stalls_{0};
+};
+
+
+// Multi-producer / multi-consumer ring of fixed-size page slots (bounded queue with per-slot sequence numbers).
+class MpmcPageRing {
+public:
+    MpmcPageRing(std::size_t slots, std::size_t pageBytes)
+        : slots_(slots), pageBytes_(pageBytes), storage_(new std::byte[slots * pageBytes]), cells_(new Cell[slots]) {
+        for (std::size_t i = 0; i < slots; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    WriteLease<MpmcPageRing> acquireWrite() {
+        for (;;) {
+            const std::uint32_t signal = signal_.load(std::memory_order_acquire);
+            std::uint64_t pos = enqueuePos_.load(std::memory_order_relaxed);
+            Cell& cell = cells_[pos % slots_];
+            const std::int64_t diff = static_cast<std::int64_t>(cell.seq.load(std::memory_order_acquire) - pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return {*this, pos, slot(pos)};
+                }
+            } else if (diff < 0) { // Full: wait for any consumer (backpressure)
+                stalls_.fetch_add(1, std::memory_order_relaxed);
+                signal_.wait(signal, std::memory_order_acquire);
+            }
+        }
+    }
+
+    ReadLease<MpmcPageRing> acquireRead() {
+        for (;;) {
+            const std::uint32_t signal = signal_.load(std::memory_order_acquire);
+            std::uint64_t pos = dequeuePos_.load(std::memory_order_relaxed);
+            Cell& cell = cells_[pos % slots_];
+            const std::int64_t diff = static_cast<std::int64_t>(cell.seq.load(std::memory_order_acquire) - (pos + 1));
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return {*this, pos, std::span<const std::byte>(slot(pos).data(), cell.size)};
+                }
+            } else if (diff < 0) { // Empty: wait for any producer, or stop once the ring was closed
+                if (closed_.load(std::memory_order_acquire)) {
+                    // The last page may have been committed between the load of "seq" above and this one: every commit is
+                    // visible now, so look again and stop only if the ring is still empty.
+                    pos = dequeuePos_.load(std::memory_order_relaxed);
+                    const std::uint64_t seq = cells_[pos % slots_].seq.load(std::memory_order_acquire);
+                    if (static_cast<std::int64_t>(seq - (pos + 1)) < 0) return {};
+                    continue;
+                }
+                signal_.wait(signal, std::memory_order_acquire);
+            }
+        }
+    }
+
+    // Called once every producer made its last commit.
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        wake();
+    }
+
+    std::size_t stalls() const { return stalls_.load(std::memory_order_relaxed); }
+
+private:
+    friend class WriteLease<MpmcPageRing>;
+    friend class ReadLease<MpmcPageRing>;
+
+    struct alignas(64) Cell {
+        std::atomic<std::uint64_t> seq;
+        std::size_t size = 0;
+    };
+
+    std::span<std::byte> slot(std::uint64_t pos) const {
+        return {storage_.get() + (pos % slots_) * pageBytes_, pageBytes_};
+    }
+
+    void commitWrite(std::uint64_t pos, std::size_t size) {
+        Cell& cell = cells_[pos % slots_];
+        cell.size = size;
+        cell.seq.store(pos + 1, std::memory_order_release);
+        wake();
+    }
+
+    void releaseRead(std::uint64_t pos) {
+        cells_[pos % slots_].seq.store(pos + slots_, std::memory_order_release);
+        wake();
+    }
+
+    // Event count: waiters sleep on "signal_" and every state change bumps it.
+    void wake() {
+        signal_.fetch_add(1, std::memory_order_release);
+        signal_.notify_all();
+    }
+
+    const std::size_t slots_;
+    const std::size_t pageBytes_;
+    std::unique_ptr<std::byte[]> storage_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<std::uint64_t> enqueuePos_{0};
+    alignas(64) std::atomic<std::uint64_t> dequeuePos_{0};
+    alignas(64) std::atomic<std::uint32_t> signal_{0};
+    std::atomic<bool> closed_{false};
+    std::atomic<std::size_t> stalls_{0};
+};
+
+
+// Pipeline stages: a producer fills slots in place, a consumer hands each slot to a device in place.
+template <typename Ring>
+std::size_t scanStage(PageScannable& scanner, Ring& ring, std::size_t pages) {
+    for (std::size_t i = 0; i < pages; ++i) {
+        auto lease = ring.acquireWrite();
+        lease.commit(scanner.scanPage(lease.buffer()));
+    }
+    return pages;
+}
+
+template <typename Ring, typename Consumer>
+std::size_t consumeStage(Ring& ring, Consumer&& consume) {
+    std::size_t pages = 0;
+    while (auto lease = ring.acquireRead()) {
+        consume(lease.page());
+        ++pages;
+    }
+    return pages;
+}
+
+template <typename Ring>
+std::size_t faxStage(PageFaxable& fax, Ring& ring) {
+    return consumeStage(ring, [&fax](std::span<const std::byte> page) { fax.faxPage(page); });
+}
+
+template <typename Ring>
+std::size_t printStage(PagePrintable& printer, Ring& ring) {
+    return consumeStage(ring, [&printer](std::span<const std::byte> page) { printer.printPage(page); });
+}
+
+
+// Synthetic devices: the scanner fills the whole page, the fax and the printer read every cache line of it.
+class SyntheticScanner : public PageScannable {
+public:
+    std::size_t scanPage(std::span<std::byte> out) override {
+        std::memset(out.data(), static_cast<int>(++pageNumber_ & 0xFF), out.size());
+        return out.size();
+    }
+
+private:
+    std::size_t pageNumber_ = 0;
+};
+
+static std::uint64_t touchPage(std::span<const std::byte> page) {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < page.size(); i += 64) sum += static_cast<std::uint64_t>(page[i]);
+    return sum;
+}
+
+class SyntheticFax : public PageFaxable {
+public:
+    void faxPage(std::span<const std::byte> page) override { checksum_ += touchPage(page); }
+    std::uint64_t checksum() const { return checksum_; }
+
+private:
+    std::uint64_t checksum_ = 0;
+};
+
+class SyntheticPrinter : public PagePrintable {
+public:
+    void printPage(std::span<const std::byte> page) override { checksum_ += touchPage(page); }
+    std::uint64_t checksum() const { return checksum_; }
+
+private:
+    std::uint64_t checksum_ = 0;
+};
+
+
+// Baseline: what we do today, every stage hands over its own copy of the page.
+class CopyingQueue {
+public:
+    explicit CopyingQueue(std::size_t capacity) : capacity_(capacity) {}
+
+    void push(std::span<const std::byte> page) {
+        std::vector<std::byte> copy(page.begin(), page.end());
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [this] { return queue_.size() < capacity_; });
+        queue_.push(std::move(copy));
+        notEmpty_.notify_one();
+    }
+
+    bool pop(std::vector<std::byte>& page) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this] { return closed_ || !queue_.empty(); });
+        if (queue_.empty()) return false;
+        page = std::move(queue_.front());
+        queue_.pop();
+        notFull_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        notEmpty_.notify_all();
+    }
+
+private:
+    std::size_t capacity_;
+    std::queue<std::vector<std::byte>> queue_;
+    std::mutex mutex_;
+    std::condition_variable notFull_, notEmpty_;
+    bool closed_ = false;
+};
+
+
+static void report(const char* name, std::size_t pages, std::size_t pageBytes, double seconds, std::size_t stalls) {
+    std::cout << name << ": " << pages << " pages in " << seconds << " s, " << pages / seconds << " pages/s, "
+              << (pages * pageBytes) / seconds / (1024.0 * 1024.0) << " MB/s, backpressure stalls: " << stalls << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    using namespace std::chrono;
+    const std::size_t pageBytes = 4 * 1024 * 1024;  // A4 at 600 dpi, 8-bit grey is roughly this size
+    std::size_t slots = 4;  // Ring depth, try a few values: deep rings fall out of the cache
+    if (argc > 1) {
+        char* end = nullptr;
+        const unsigned long requested = std::strtoul(argv[1], &end, 10);
+        if (end == argv[1] || *end != '\0' || argv[1][0] == '-' || requested < 1 || requested > 256) {
+            std::cerr << "Usage: " << argv[0] << " [slots, 1 to 256 (4 MB each)]" << std::endl;
+            return 1;
+        }
+        slots = requested;
+    }
+    const std::size_t pages = 256;
+
+    // 1) Scanner -> Fax over the SPSC ring.
+    {
+        SpscPageRing ring(slots, pageBytes);
+        SyntheticScanner scanner;
+        SyntheticFax fax;
+
+        auto start = steady_clock::now();
+        std::thread producer([&] { scanStage(scanner, ring, pages); ring.close(); });
+        std::size_t faxed = faxStage(fax, ring);
+        producer.join();
+        report("SPSC scan->fax       ", faxed, pageBytes, duration<double>(steady_clock::now() - start).count(), ring.stalls());
+    }
+
+    // 2) Scanner -> two fax lines and a printer over the MPMC ring.
+    {
+        MpmcPageRing ring(slots, pageBytes);
+        SyntheticScanner scanner;
+        SyntheticFax fax1, fax2;
+        SyntheticPrinter printer;
+        std::atomic<std::size_t> consumed{0};
+
+        auto start = steady_clock::now();
+        std::thread producer([&] { scanStage(scanner, ring, pages); ring.close(); });
+        std::thread line1([&] { consumed += faxStage(fax1, ring); });
+        std::thread line2([&] { consumed += faxStage(fax2, ring); });
+        consumed += printStage(printer, ring);
+        producer.join();
+        line1.join();
+        line2.join();
+        report("MPMC scan->fax/print ", consumed.load(), pageBytes, duration<double>(steady_clock::now() - start).count(), ring.stalls());
+    }
+
+    // 3) Baseline: the scanner scans into its own buffer and every hand-over copies the page.
+    {
+        CopyingQueue queue(slots);
+        SyntheticScanner scanner;
+        SyntheticFax fax;
+        std::size_t faxed = 0;
+
+        auto start = steady_clock::now();
+        std::thread producer([&] {
+            std::vector<std::byte> scratch(pageBytes);
+            for (std::size_t i = 0; i < pages; ++i) {
+                scanner.scanPage(scratch);
+                queue.push(scratch);
+            }
+            queue.close();
+        });
+        std::vector<std::byte> page;
+        while (queue.pop(page)) {
+            fax.faxPage(page);
+            ++faxed;
+        }
+        producer.join();
+        report("Copying queue        ", faxed, pageBytes, duration<double>(steady_clock::now() - start).count(), 0);
+    }
+
+    getchar();
+    return 0;
+}
+
+
+/**
+ * \brief   Note that the memory used by the pipeline is fixed when the ring is created (slots * page size), a slow fax line can never
+ *          make the scanner allocate more pages, it only makes "acquireWrite()" wait until a slot is released.
+ *
+ *          Note: a ReadLease must not outlive its ring, and a page must not be used after its lease was destroyed because the
+ *                producer may already be writing the next page into the same slot.
+*/
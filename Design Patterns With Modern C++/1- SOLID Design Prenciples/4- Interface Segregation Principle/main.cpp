@@ -19,6 +19,8 @@
 #include <vector>
 #include <fstream>
 
+#include "../../Utilities/LogSink.hpp"  // Buffered replacement for "std::cout << ... << std::endl"
+
 /**
  * \brief The following example will demonstrate a violation for ISP concept, so make sure to read the example well before reading
  *        the conclusion.
@@ -126,7 +128,7 @@ public:
 class Printer : public Printable {
 public:
     void print() override {
-        std::cout << "Printing..." << std::endl;
+        logLine("Printing...");
     }
 };
 
@@ -134,7 +136,7 @@ public:
 class Scanner : public Scannable {
 public:
     void scan() override {
-        std::cout << "Scanning..." << std::endl;
+        logLine("Scanning...");
     }
 };
 
@@ -142,7 +144,7 @@ public:
 class Fax : public Faxable {
 public:
     void fax() override {
-        std::cout << "Faxing..." << std::endl;
+        logLine("Faxing...");
     }
 };
 
@@ -150,11 +152,11 @@ public:
 class PrinterScanner : public Printable , public Faxable {
 public:
     void fax() override {
-        std::cout << "Faxing and Printing..." << std::endl;
+        logLine("Faxing and Printing...");
     }
 
     void print() override {
-        std::cout << "Printing and Faxing..." << std::endl;
+        logLine("Printing and Faxing...");
     }
 };
 
@@ -0,0 +1,72 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Records per second through "BusinessLogic::processData()" with group commit, for batch sizes 1 to 4096.
+ *
+ *        The backend appends every record to a file and flushes it after each write, so every call to the database costs a system call
+ *        (the "per-write overhead"). Its "saveBatch()" writes a whole group with a single flush, which is exactly what group commit amortizes.
+ *
+ *        "BusinessLogic" logs every record to stdout, so run it with stdout redirected and read the results on stderr:
+ *            g++ -std=c++20 -O2 -pthread "Batch Benchmark.cpp" -o BatchBenchmark
+ *            ./BatchBenchmark > /dev/null
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "DatabaseInterface.hpp"
+
+
+// Low-level module: appends one record per line to a file.
+class AppendFileDatabase : public DatabaseInterface {
+public:
+    explicit AppendFileDatabase(const std::string& path) : file_(std::fopen(path.c_str(), "wb")) {}
+    ~AppendFileDatabase() override { if (file_) std::fclose(file_); }
+
+    void saveData(const std::string& data) override {
+        std::fwrite(data.data(), 1, data.size(), file_);
+        std::fputc('\n', file_);
+        std::fflush(file_);  // One write to the OS per record
+    }
+
+    void saveBatch(std::span<const std::string_view> records) override {
+        for (std::string_view r : records) {
+            std::fwrite(r.data(), 1, r.size(), file_);
+            std::fputc('\n', file_);
+        }
+        std::fflush(file_);  // One write to the OS per group
+    }
+
+private:
+    std::FILE* file_;
+};
+
+int main() {
+    const int records = 200000;
+    const std::string path = "batch_benchmark.db";
+    const std::string payload(100, 'x');
+
+    std::cerr << "batch size | records/s" << std::endl;
+    for (std::size_t batch = 1; batch <= 4096; batch *= 4) {
+        AppendFileDatabase database(path);
+        auto start = std::chrono::steady_clock::now();
+        {
+            BusinessLogic businessLogic(&database, GroupCommitPolicy{batch, std::chrono::milliseconds(10)});
+            for (int i = 0; i < records; ++i) businessLogic.processData(payload);
+        } // The destructor commits the last group
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cerr << batch << "\t   | " << records / seconds << std::endl;
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Hot-key reads through "loadData()": a "LogStructuredDatabase" whose records live in segment files, read directly and
+ *        through a "CachedDatabase" that holds far less than the whole data set. 90% of the reads go to 1% of the keys,
+ *        and every 100th operation overwrites a key, to exercise the write-through invalidation.
+ *
+ *        Build: g++ -std=c++20 -O2 -pthread "Cache Benchmark.cpp" -o CacheBenchmark
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <filesystem>
+
+#include "LogStructuredDatabase.hpp"
+#include "CachedDatabase.hpp"
+
+
+using Clock = std::chrono::steady_clock;
+
+static void readWorkload(const char* name, DatabaseInterface& database, int keys, int operations) {
+    std::mt19937 rng(7);
+    std::bernoulli_distribution hot(0.9);
+    std::uniform_int_distribution<int> hotKey(0, keys / 100 - 1);
+    std::uniform_int_distribution<int> anyKey(0, keys - 1);
+
+    std::vector<Clock::duration> latencies;
+    latencies.reserve(operations);
+    int found = 0;
+    for (int i = 0; i < operations; ++i) {
+        const std::string key = "key" + std::to_string(hot(rng) ? hotKey(rng) : anyKey(rng));
+        if (i % 100 == 0) {
+            database.saveData(key + "=updated" + std::to_string(i));
+            continue;
+        }
+        auto start = Clock::now();
+        found += database.loadData(key).has_value();
+        latencies.push_back(Clock::now() - start);
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto ns = [](Clock::duration d) { return std::chrono::duration<double, std::nano>(d).count(); };
+    double total = 0;
+    for (auto d : latencies) total += ns(d);
+    std::cout << name << ": mean = " << total / latencies.size() << " ns, p50 = " << ns(latencies[latencies.size() / 2])
+              << " ns, p99 = " << ns(latencies[latencies.size() * 99 / 100]) << " ns, found " << found << "/"
+              << latencies.size() << std::endl;
+}
+
+int main() {
+    namespace fs = std::filesystem;
+    const int keys = 100000;
+    const int operations = 500000;
+
+    fs::remove_all("cache_bench");
+    LogStructuredDatabase backend(LogStructuredOptions{"cache_bench", FsyncPolicy::Never, std::chrono::milliseconds(50), 1 << 20});
+    {
+        std::vector<std::string> records;
+        std::vector<std::string_view> views;
+        for (int i = 0; i < keys; ++i) records.push_back("key" + std::to_string(i) + "=" + std::string(100, 'v'));
+        views.assign(records.begin(), records.end());
+        backend.saveBatch(views);
+    }
+
+    readWorkload("Without cache", backend, keys, operations);
+
+    CachedDatabase cached(backend, 1 << 20); // 1 MB: roughly 5% of the data set
+    readWorkload("With cache   ", cached, keys, operations);
+
+    auto stats = cached.stats();
+    std::cout << "Cache: hits = " << stats.hits << ", misses = " << stats.misses << ", hit rate = "
+              << 100.0 * stats.hits / (stats.hits + stats.misses) << "%, evictions = " << stats.evictions
+              << ", invalidations = " << stats.invalidations << ", bytes = " << stats.bytes << std::endl;
+
+    // Write-through invalidation: a read right after a save sees the new record, not the cached one.
+    cached.loadData("key1");
+    cached.saveData("key1=fresh");
+    std::cout << "After saveData: " << cached.loadData("key1").value_or("<missing>") << std::endl; // Output: key1=fresh
+
+    fs::remove_all("cache_bench");
+
+    getchar();
+    return 0;
+}
@@ -0,0 +1,205 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief CachedDatabase: a read cache in front of any "DatabaseInterface" backend, again as a decorator.
+ *
+ *        - loadData() answers from memory when it can (hit) and only asks the backend on a miss, then keeps the answer.
+ *        - saveData()/saveBatch() are written through to the backend and drop the cached copy of the key (invalidation),
+ *          so the next read fetches the new record.
+ *        - Memory is bounded in bytes ("capacityBytes"). The cache is split into shards, each with its own lock and a CLOCK
+ *          eviction hand: every entry has a "referenced" bit that a hit sets, and the hand evicts the first entry whose bit is
+ *          clear (clearing the bits it passes). That approximates LRU without moving anything on a hit, so hits only take a
+ *          shared lock.
+ *        - hits, misses, evictions and invalidations are counted per shard and summed by stats().
+ *
+ *        Thread safety: thread-safe as long as the backend is.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "DatabaseInterface.hpp"
+
+
+class CachedDatabase : public DatabaseInterface {
+public:
+    struct Stats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+        std::uint64_t invalidations = 0;
+        std::size_t bytes = 0;
+    };
+
+    CachedDatabase(DatabaseInterface& backend, std::size_t capacityBytes, std::size_t shards = 16)
+        : backend_(backend), shards_(std::make_unique<Shard[]>(shards)), shardCount_(shards),
+          shardCapacity_(shards ? capacityBytes / shards : 0) {
+        if (shards == 0) throw std::invalid_argument("CachedDatabase: shards must be at least 1");
+    }
+
+    void saveData(const std::string& data) override {
+        backend_.saveData(data);
+        invalidate(recordKey(data));
+    }
+
+    void saveBatch(std::span<const std::string_view> records) override {
+        backend_.saveBatch(records);
+        for (std::string_view r : records) invalidate(recordKey(r));
+    }
+
+    std::optional<std::string> loadData(std::string_view key) override {
+        Shard& shard = shardOf(key);
+        std::uint64_t version;
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.index.find(key);
+            if (it != shard.index.end()) {
+                Entry& entry = shard.entries[it->second];
+                entry.referenced.store(true, std::memory_order_relaxed);
+                shard.hits.fetch_add(1, std::memory_order_relaxed);
+                return entry.record;
+            }
+            version = shard.version;
+        }
+
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        std::optional<std::string> record = backend_.loadData(key);
+        if (record) insert(shard, key, *record, version);
+        return record;
+    }
+
+    Stats stats() const {
+        Stats s;
+        for (std::size_t i = 0; i < shardCount_; ++i) {
+            const Shard& shard = shards_[i];
+            s.hits += shard.hits.load(std::memory_order_relaxed);
+            s.misses += shard.misses.load(std::memory_order_relaxed);
+            s.evictions += shard.evictions.load(std::memory_order_relaxed);
+            s.invalidations += shard.invalidations.load(std::memory_order_relaxed);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            s.bytes += shard.bytes;
+        }
+        return s;
+    }
+
+private:
+    struct KeyHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+    };
+
+    struct Entry {
+        std::string key;                       // May be empty: "=value" is a record too
+        std::string record;
+        bool occupied = false;                 // False when the slot is free
+        std::atomic<bool> referenced{false};   // Set by hits (under a shared lock), cleared by the CLOCK hand
+
+        Entry() = default;
+        Entry(Entry&& other) noexcept
+            : key(std::move(other.key)), record(std::move(other.record)), occupied(other.occupied),
+              referenced(other.referenced.load(std::memory_order_relaxed)) {}
+
+        std::size_t bytes() const { return key.size() + record.size() + sizeof(Entry); }
+    };
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, std::size_t, KeyHash, std::equal_to<>> index;   // key -> slot in "entries"
+        std::vector<Entry> entries;                                                       // The CLOCK ring
+        std::vector<std::size_t> freeSlots;
+        std::size_t hand = 0;
+        std::size_t bytes = 0;
+        std::uint64_t version = 0;   // Bumped by every invalidation, so a miss cannot cache a record that was overwritten meanwhile
+
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+        std::atomic<std::uint64_t> evictions{0};
+        std::atomic<std::uint64_t> invalidations{0};
+    };
+
+    Shard& shardOf(std::string_view key) const {
+        return shards_[KeyHash{}(key) % shardCount_];
+    }
+
+    void insert(Shard& shard, std::string_view key, const std::string& record, std::uint64_t version) {
+        const std::size_t bytes = key.size() + record.size() + sizeof(Entry);
+        if (bytes > shardCapacity_) return; // Would evict the whole shard, not worth it
+
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (shard.version != version || shard.index.count(key)) return;
+
+        while (shard.bytes + bytes > shardCapacity_) evictOne(shard);
+
+        std::size_t slot;
+        if (!shard.freeSlots.empty()) {
+            slot = shard.freeSlots.back();
+            shard.freeSlots.pop_back();
+        } else {
+            slot = shard.entries.size();
+            shard.entries.emplace_back();
+        }
+        Entry& entry = shard.entries[slot];
+        entry.key.assign(key);
+        entry.record = record;
+        entry.occupied = true;
+        entry.referenced.store(false, std::memory_order_relaxed);
+        shard.index.emplace(entry.key, slot);
+        shard.bytes += bytes;
+    }
+
+    // Second chance: skip (and clear) referenced entries, evict the first one that was not used since the hand last passed.
+    void evictOne(Shard& shard) {
+        for (;;) {
+            if (shard.hand >= shard.entries.size()) shard.hand = 0;
+            Entry& entry = shard.entries[shard.hand++];
+            if (!entry.occupied) continue;
+            if (entry.referenced.exchange(false, std::memory_order_relaxed)) continue;
+            release(shard, entry);
+            shard.evictions.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    void release(Shard& shard, Entry& entry) {
+        const std::size_t slot = static_cast<std::size_t>(&entry - shard.entries.data());
+        shard.bytes -= entry.bytes();
+        shard.index.erase(entry.key);
+        entry.key.clear();
+        entry.record.clear();
+        entry.occupied = false;
+        entry.record.shrink_to_fit();
+        shard.freeSlots.push_back(slot);
+    }
+
+    void invalidate(std::string_view key) {
+        Shard& shard = shardOf(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        ++shard.version;
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) return;
+        release(shard, shard.entries[it->second]);
+        shard.invalidations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    DatabaseInterface& backend_;
+    std::unique_ptr<Shard[]> shards_;
+    std::size_t shardCount_;
+    std::size_t shardCapacity_;
+};
@@ -0,0 +1,62 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Many request threads sharing one "DatabaseInterface*": a single mutex ("StripedMemoryDatabase(1)") vs. 64 lock stripes,
+ *        from 1 to 64 threads. The threads call "saveData()" through the abstraction, exactly like "BusinessLogic" does, but without
+ *        its logging so that only the database is measured.
+ *
+ *        Build: g++ -std=c++20 -O2 -pthread "Contention Benchmark.cpp" -o ContentionBenchmark
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#include "StripedMemoryDatabase.hpp"
+
+
+static double savesPerSecond(DatabaseInterface* database, unsigned threads, int savesPerThread) {
+    // Records are built up-front so only the saves are timed.
+    std::vector<std::vector<std::string>> records(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        for (int i = 0; i < savesPerThread; ++i) {
+            records[t].push_back("t" + std::to_string(t) + "-key" + std::to_string(i % 4096) + "=payload");
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([database, &mine = records[t]] {
+            for (const auto& record : mine) database->saveData(record);
+        });
+    }
+    for (auto& w : workers) w.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return threads * static_cast<double>(savesPerThread) / seconds;
+}
+
+int main() {
+    const int savesPerThread = 50000;
+
+    std::cout << "threads | single mutex (saves/s) | 64 stripes (saves/s)" << std::endl;
+    for (unsigned threads = 1; threads <= 64; threads *= 2) {
+        StripedMemoryDatabase singleMutex(1);
+        StripedMemoryDatabase striped(64);
+        double single = savesPerSecond(&singleMutex, threads, savesPerThread);
+        double shards = savesPerSecond(&striped, threads, savesPerThread);
+        std::cout << threads << "\t| " << single << "\t\t | " << shards << std::endl;
+    }
+
+    getchar();
+    return 0;
+}
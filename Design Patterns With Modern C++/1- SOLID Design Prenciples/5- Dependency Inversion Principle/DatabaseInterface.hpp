@@ -0,0 +1,222 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief The abstraction from "main.cpp" ("DatabaseInterface"), its concrete "Database" and the high-level "BusinessLogic",
+ *        moved into a header so the other examples of this folder (backends, decorators, benchmarks) can depend on the same abstraction.
+ *
+ *        Build (any file including this header): g++ -std=c++20 -pthread <file>.cpp
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <optional>
+#include <concepts>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
+#include <utility>
+
+#include "../../Utilities/LogSink.hpp"
+
+
+// Records are "key=value" strings: the key is everything before the first '=' (a record without '=' is its own key).
+// Backends that need a key (lookups, sharding, log-structured storage) all follow this convention.
+inline std::string_view recordKey(std::string_view record) {
+    const auto separator = record.find('=');
+    return separator == std::string_view::npos ? record : record.substr(0, separator);
+}
+
+// Abstract interface for database operations
+//
+// Thread safety: every implementation must say whether it may be called from several threads at once.
+//   - "thread-safe"       : saveData()/saveBatch() may be called concurrently on the same object, a record saved by one thread
+//                           is visible to every call that starts after saveData() returned.
+//   - "single-threaded"   : the caller must serialize the calls (one thread at a time, or an external lock).
+// An implementation that says nothing is single-threaded, so a DatabaseInterface* shared by several request threads
+// must point to a thread-safe implementation.
+class DatabaseInterface {
+public:
+    virtual void saveData(const std::string& data) = 0;
+
+    // Saves a group of records in one call. The default falls back to one "saveData()" per record,
+    // backends override it when they can amortize their per-write overhead (one system call, one lock, one transaction...).
+    virtual void saveBatch(std::span<const std::string_view> records) {
+        std::string record;
+        for (std::string_view r : records) {
+            record.assign(r);
+            saveData(record);
+        }
+    }
+
+    // Latest record saved under "key" (see recordKey()), or nothing if there is none.
+    // Write-only backends (like "Database" below, which only logs) keep the default and never find anything.
+    virtual std::optional<std::string> loadData(std::string_view key) {
+        (void)key;
+        return std::nullopt;
+    }
+
+    virtual ~DatabaseInterface() = default;
+};
+
+// Low-level module: Concrete Database implementation (thread-safe, LogSink is)
+class Database : public DatabaseInterface {
+public:
+    void saveData(const std::string& data) override {
+        logLine("Saving data to database: ", data);
+    }
+};
+
+// Compile-time mirror of DatabaseInterface: any type with the same three operations, whether it derives from it or not.
+template <typename Db>
+concept DatabaseBackend = requires(Db& db, const std::string& record, std::span<const std::string_view> records,
+                                   std::string_view key) {
+    db.saveData(record);
+    db.saveBatch(records);
+    { db.loadData(key) } -> std::convertible_to<std::optional<std::string>>;
+};
+
+static_assert(DatabaseBackend<DatabaseInterface>);
+
+// When "BusinessLogic" hands its records over to the database.
+// The defaults (one record, no delay) save every record as soon as it is processed.
+//
+// With a "maxDelay", a timer thread of the BusinessLogic commits a partial group once its oldest record is that old,
+// so a group followed by silence still reaches the database. Without one, it waits for the next record, an explicit
+// BusinessLogic::flush(), or the BusinessLogic's destruction.
+struct GroupCommitPolicy {
+    std::size_t maxRecords = 1;                                        // Commit once this many records are pending
+    std::chrono::microseconds maxDelay = std::chrono::microseconds(0); // ...or once the oldest pending one is this old (0: no deadline)
+};
+
+// High-level module: BusinessLogic (Depends on DatabaseInterface via Dependency Injection)
+//
+// "BusinessLogic" (= BusinessLogic<DatabaseInterface>) calls its database through the vtable, so any backend can be plugged in at run time.
+// When the backend is fixed at build time, "BusinessLogic<ConcreteDb>" calls it directly and the compiler can inline the call
+// (ConcreteDb must either not derive from DatabaseInterface or be declared "final", otherwise the call is still virtual).
+//
+// Thread safety: with the default policy (no grouping) processData() keeps no state, so one BusinessLogic may be shared by
+// several threads as long as its database is thread-safe. With group commit the pending group is behind a mutex it shares
+// with the timer thread: sharing still works but the threads contend on it, one BusinessLogic per thread scales better.
+// The database is then also called from the timer thread, so it must be thread-safe whenever "maxDelay" is set.
+template <DatabaseBackend Db = DatabaseInterface>
+class BusinessLogic {
+private:
+    Db* database; // Using a shared pointer will be much better, but I used a raw pointer for simpleness.
+                  // std::shared_ptr<DatabaseInterface> database;
+    GroupCommitPolicy policy;
+    std::mutex mutex;                      // Guards everything below but "timer"
+    std::vector<std::string> pending;
+    std::vector<std::string_view> group;   // Reused views over "pending" handed to saveBatch()
+    std::chrono::steady_clock::time_point oldestPending;
+    std::condition_variable timerCv;
+    bool stopping = false;
+    std::exception_ptr timerFailure;       // What the timer's commit threw, rethrown by the next ingest() or flush()
+    std::thread timer;                     // Only with group commit and a "maxDelay"
+
+public:
+    // Constructor injection of DatabaseInterface
+    BusinessLogic(Db* db, GroupCommitPolicy commitPolicy = {}) : database(db), policy(commitPolicy) {
+        pending.reserve(policy.maxRecords);
+        if (policy.maxRecords > 1 && policy.maxDelay.count() > 0) timer = std::thread([this] { timerLoop(); });
+    }
+
+    BusinessLogic(const BusinessLogic&) = delete;
+    BusinessLogic& operator=(const BusinessLogic&) = delete;
+
+    ~BusinessLogic() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        timerCv.notify_one();
+        if (timer.joinable()) timer.join();
+        commitPending();   // A group the timer failed to commit gets one last try
+    }
+
+    void processData(const std::string& data) {
+        // Perform business logic
+        logLine("Processing data: ", data);
+
+        ingest(data);
+    }
+
+    // processData() without the per-record log line, for hot ingest paths.
+    void ingest(const std::string& data) {
+        // Save processed data using DatabaseInterface (abstraction)
+        if (policy.maxRecords <= 1) {
+            database->saveData(data);
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        rethrowTimerFailure();
+        const bool first = pending.empty();
+        if (first) oldestPending = std::chrono::steady_clock::now();
+        pending.push_back(data);
+        if (pending.size() >= policy.maxRecords) {
+            commitPending();
+        } else if (first && timer.joinable()) {
+            lock.unlock();
+            timerCv.notify_one();   // A new deadline
+        }
+    }
+
+    // Commits the pending group right away, without waiting for its deadline (the destructor calls it too).
+    void flush() {
+        std::lock_guard<std::mutex> lock(mutex);
+        rethrowTimerFailure();
+        commitPending();
+    }
+
+private:
+    // Caller holds "mutex" (or is the destructor). The group stays pending if the database throws.
+    void commitPending() {
+        if (pending.empty()) return;
+        group.assign(pending.begin(), pending.end());
+        database->saveBatch(group);
+        pending.clear();
+    }
+
+    // Caller holds "mutex". Reported once, then the timer retries the group.
+    void rethrowTimerFailure() {
+        if (!timerFailure) return;
+        timerCv.notify_one();
+        std::rethrow_exception(std::exchange(timerFailure, nullptr));
+    }
+
+    void timerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            if (pending.empty() || timerFailure) {
+                timerCv.wait(lock);
+                continue;
+            }
+            const auto deadline = oldestPending + policy.maxDelay;
+            if (std::chrono::steady_clock::now() < deadline) {
+                timerCv.wait_until(lock, deadline);
+                continue;
+            }
+            try {
+                commitPending();
+            } catch (...) {
+                timerFailure = std::current_exception();
+            }
+        }
+    }
+};
+
+// "BusinessLogic logic(&anyDatabase)" keeps the run-time polymorphic version, the compile-time one must be asked for by name.
+template <typename Db>
+BusinessLogic(Db*, GroupCommitPolicy = {}) -> BusinessLogic<DatabaseInterface>;
@@ -0,0 +1,313 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Load generator for "BusinessLogic::processData()" against any "DatabaseInterface" backend of this folder,
+ *        to qualify a backend change under a realistic load before shipping it.
+ *
+ *        Two ways of applying load:
+ *          - closed loop ("--mode closed --clients N"): N clients, each sends its next request as soon as the previous one returned.
+ *            Measures the best throughput, but a slow backend also slows the clients down, so it under-reports stalls.
+ *          - open loop ("--mode open --qps R"): requests are scheduled at a fixed rate R whatever the backend does, and the latency
+ *            is measured from the time the request was due, not the time a client got around to send it. A stall therefore shows
+ *            up in the latency of every request queued behind it (no "coordinated omission").
+ *        Every client has its own "BusinessLogic" (optionally with group commit) over the shared backend.
+ *
+ *        Payload sizes follow a distribution read from a file ("--payloads"): one "<bytes> [<weight>]" per line, '#' starts
+ *        a comment (see "Load Generator Payloads.txt"). Without a file: 64 B (70%), 512 B (25%), 4 KB (5%).
+ *
+ *        The report (throughput and latency histograms, see "LatencyHistogram.hpp") goes to stderr as text, and to "--json <file>".
+ *        "processData()" logs every record to stdout, so redirect it:
+ *            g++ -std=c++20 -O2 -pthread "Load Generator.cpp" -o LoadGenerator
+ *            ./LoadGenerator --backend log --mode open --qps 20000 --clients 4 --duration 10 --json report.json > /dev/null
+ *
+ *        Backends: "console" ("Database"), "memory" ("StripedMemoryDatabase"), "log" ("LogStructuredDatabase"),
+ *                  "write-behind" (over "log"), "sharded" (4 "StripedMemoryDatabase").
+ */
+
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <filesystem>
+
+#include "DatabaseInterface.hpp"
+#include "StripedMemoryDatabase.hpp"
+#include "LogStructuredDatabase.hpp"
+#include "WriteBehindDatabase.hpp"
+#include "ShardedDatabase.hpp"
+#include "../../Utilities/LatencyHistogram.hpp"
+
+
+using Clock = std::chrono::steady_clock;
+
+struct LoadOptions {
+    std::string backend = "memory";
+    std::string mode = "closed";
+    unsigned clients = 4;
+    double qps = 10000;              // Open loop only
+    double duration = 5;             // Seconds measured
+    double warmup = 1;               // Seconds run before measuring
+    std::size_t keys = 100000;       // Distinct keys written
+    std::size_t group = 1;           // GroupCommitPolicy::maxRecords of every client
+    std::string payloads;            // Payload size distribution file
+    std::string json;                // JSON report file
+};
+
+struct PayloadSize {
+    std::size_t bytes;
+    double weight;
+};
+
+// The backend and whatever it is built on, kept alive for the whole run.
+struct Backend {
+    std::vector<std::unique_ptr<DatabaseInterface>> parts;
+    DatabaseInterface* top = nullptr;
+    std::filesystem::path directory;
+
+    ~Backend() {
+        while (!parts.empty()) parts.pop_back();   // Decorators first, then what they wrap
+        if (!directory.empty()) std::filesystem::remove_all(directory);
+    }
+};
+
+static std::unique_ptr<Backend> makeBackend(const std::string& name) {
+    auto backend = std::make_unique<Backend>();
+    auto add = [&](std::unique_ptr<DatabaseInterface> part) {
+        backend->top = part.get();
+        backend->parts.push_back(std::move(part));
+    };
+
+    if (name == "console") {
+        add(std::make_unique<Database>());
+    } else if (name == "memory") {
+        add(std::make_unique<StripedMemoryDatabase>());
+    } else if (name == "log" || name == "write-behind") {
+        backend->directory = "loadgen_data";
+        std::filesystem::remove_all(backend->directory);
+        auto log = std::make_unique<LogStructuredDatabase>(LogStructuredOptions{backend->directory});
+        LogStructuredDatabase& storage = *log;
+        add(std::move(log));
+        if (name == "write-behind") {
+            WriteBehindOptions options;
+            options.onBarrier = [&storage] { storage.sync(); };
+            add(std::make_unique<WriteBehindDatabase>(storage, options));
+        }
+    } else if (name == "sharded") {
+        auto sharded = std::make_unique<ShardedDatabase>();
+        for (int i = 0; i < 4; ++i) {
+            auto child = std::make_unique<StripedMemoryDatabase>();
+            sharded->addShard("shard" + std::to_string(i), *child);
+            backend->parts.push_back(std::move(child));
+        }
+        add(std::move(sharded));
+    } else {
+        throw std::invalid_argument("unknown backend: " + name);
+    }
+    return backend;
+}
+
+static std::vector<PayloadSize> readPayloadSizes(const std::string& path) {
+    if (path.empty()) return {{64, 70}, {512, 25}, {4096, 5}};
+
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("cannot open " + path);
+    std::vector<PayloadSize> sizes;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        PayloadSize size{0, 1};
+        if (!(fields >> size.bytes)) continue;
+        fields >> size.weight;
+        if (size.weight > 0) sizes.push_back(size);
+    }
+    if (sizes.empty()) throw std::runtime_error("no payload sizes in " + path);
+    return sizes;
+}
+
+static LoadOptions parseArguments(int argc, char* argv[]) {
+    LoadOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (i + 1 >= argc) throw std::invalid_argument("missing value for " + flag);
+        const std::string value = argv[++i];
+        if (flag == "--backend") options.backend = value;
+        else if (flag == "--mode") options.mode = value;
+        else if (flag == "--clients") options.clients = static_cast<unsigned>(std::stoul(value));
+        else if (flag == "--qps") options.qps = std::stod(value);
+        else if (flag == "--duration") options.duration = std::stod(value);
+        else if (flag == "--warmup") options.warmup = std::stod(value);
+        else if (flag == "--keys") options.keys = std::stoul(value);
+        else if (flag == "--group") options.group = std::stoul(value);
+        else if (flag == "--payloads") options.payloads = value;
+        else if (flag == "--json") options.json = value;
+        else throw std::invalid_argument("unknown option " + flag);
+    }
+    if (options.mode != "open" && options.mode != "closed") throw std::invalid_argument("--mode must be open or closed");
+    if (options.clients == 0 || options.qps <= 0 || options.duration <= 0 || options.keys == 0 || options.group == 0) {
+        throw std::invalid_argument("--clients, --qps, --duration, --keys and --group must be positive");
+    }
+    return options;
+}
+
+// What one client measured, merged at the end.
+struct ClientResult {
+    LatencyHistogram latency;   // Open loop: from the time the request was due. Closed loop: same as the service time.
+    LatencyHistogram service;   // From the call to processData() to its return
+    std::uint64_t errors = 0;
+    std::uint64_t bytes = 0;
+};
+
+class LoadGenerator {
+public:
+    LoadGenerator(const LoadOptions& options, DatabaseInterface& database, std::vector<PayloadSize> sizes)
+        : options_(options), database_(database), sizes_(std::move(sizes)) {
+        std::vector<double> weights;
+        for (const auto& s : sizes_) {
+            weights.push_back(s.weight);
+            maxPayload_ = std::max(maxPayload_, s.bytes);
+        }
+        pick_ = std::discrete_distribution<std::size_t>(weights.begin(), weights.end());
+    }
+
+    ClientResult run() {
+        start_ = Clock::now();
+        measureFrom_ = start_ + toDuration(options_.warmup);
+        end_ = measureFrom_ + toDuration(options_.duration);
+
+        std::vector<ClientResult> results(options_.clients);
+        std::vector<std::thread> clients;
+        for (unsigned c = 0; c < options_.clients; ++c) {
+            clients.emplace_back([this, c, &results] { client(c, results[c]); });
+        }
+        for (auto& t : clients) t.join();
+
+        ClientResult total;
+        for (const auto& r : results) {
+            total.latency.merge(r.latency);
+            total.service.merge(r.service);
+            total.errors += r.errors;
+            total.bytes += r.bytes;
+        }
+        return total;
+    }
+
+private:
+    static Clock::duration toDuration(double seconds) {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    }
+
+    // sleep_until() alone wakes up tens of microseconds late, which would show up as latency: sleep, then yield the rest.
+    static void waitUntil(Clock::time_point due) {
+        const auto slack = std::chrono::microseconds(60);
+        if (due - Clock::now() > slack) std::this_thread::sleep_until(due - slack);
+        while (Clock::now() < due) std::this_thread::yield();
+    }
+
+    void client(unsigned id, ClientResult& result) {
+        BusinessLogic businessLogic(&database_, GroupCommitPolicy{options_.group, std::chrono::milliseconds(5)});
+        std::mt19937_64 rng(id + 1);
+        std::uniform_int_distribution<std::size_t> anyKey(0, options_.keys - 1);
+        auto pick = pick_;
+        const std::string filler(maxPayload_, 'x');
+        std::string record;
+
+        const Clock::duration period = toDuration(1.0 / options_.qps);
+        for (;;) {
+            // Open loop: take the next slot of the global schedule and wait for it. Closed loop: go now.
+            Clock::time_point due;
+            if (options_.mode == "open") {
+                due = start_ + period * next_.fetch_add(1, std::memory_order_relaxed);
+                if (due >= end_) break;
+                waitUntil(due);
+            } else {
+                due = Clock::now();
+                if (due >= end_) break;
+            }
+
+            record = "key" + std::to_string(anyKey(rng)) + "=";
+            record.append(filler, 0, sizes_[pick(rng)].bytes);
+
+            const Clock::time_point sent = Clock::now();
+            bool failed = false;
+            try {
+                businessLogic.processData(record);
+            } catch (const std::exception&) {
+                failed = true;
+            }
+            const Clock::time_point done = Clock::now();
+
+            if (due < measureFrom_) continue;
+            if (failed) { ++result.errors; continue; }
+            result.latency.record(done - due);
+            result.service.record(done - sent);
+            result.bytes += record.size();
+        }
+    }
+
+    const LoadOptions& options_;
+    DatabaseInterface& database_;
+    std::vector<PayloadSize> sizes_;
+    std::discrete_distribution<std::size_t> pick_;
+    std::size_t maxPayload_ = 0;
+    Clock::time_point start_, measureFrom_, end_;
+    std::atomic<std::uint64_t> next_{0};   // Next slot of the open-loop schedule
+};
+
+static std::string jsonReport(const LoadOptions& options, const ClientResult& result) {
+    const double requests = static_cast<double>(result.latency.count());
+    std::string json = "{\"backend\":\"" + options.backend + "\",\"mode\":\"" + options.mode + "\",\"clients\":" +
+                       std::to_string(options.clients) + ",\"group\":" + std::to_string(options.group) + ",\"durationSeconds\":" +
+                       std::to_string(options.duration);
+    if (options.mode == "open") json += ",\"targetQps\":" + std::to_string(options.qps);
+    json += ",\"requests\":" + std::to_string(result.latency.count()) + ",\"errors\":" + std::to_string(result.errors) +
+            ",\"throughput\":" + std::to_string(requests / options.duration) + ",\"megabytesPerSecond\":" +
+            std::to_string(result.bytes / options.duration / (1024 * 1024)) + ",\"latencyNs\":" + result.latency.json() +
+            ",\"serviceTimeNs\":" + result.service.json() + "}";
+    return json;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        const LoadOptions options = parseArguments(argc, argv);
+        auto backend = makeBackend(options.backend);
+        LoadGenerator generator(options, *backend->top, readPayloadSizes(options.payloads));
+
+        ClientResult result = generator.run();
+        defaultLogSink().flush();
+
+        std::cerr << options.mode << " loop, backend " << options.backend << ", " << options.clients << " clients";
+        if (options.mode == "open") std::cerr << ", target " << options.qps << " requests/s";
+        std::cerr << ", " << options.duration << " s\n"
+                  << "  throughput : " << result.latency.count() / options.duration << " requests/s, "
+                  << result.bytes / options.duration / (1024 * 1024) << " MB/s, " << result.errors << " errors\n"
+                  << "  latency ns : " << result.latency.text() << "\n"
+                  << "  service ns : " << result.service.text() << std::endl;
+
+        if (!options.json.empty()) {
+            std::ofstream(options.json) << jsonReport(options, result) << "\n";
+            std::cerr << "  JSON report: " << options.json << std::endl;
+        }
+        return result.errors == 0 ? 0 : 2;
+    } catch (const std::exception& e) {
+        std::cerr << "LoadGenerator: " << e.what() << "\n"
+                  << "Usage: LoadGenerator [--backend console|memory|log|write-behind|sharded] [--mode closed|open]\n"
+                  << "                     [--clients N] [--qps R] [--duration s] [--warmup s] [--keys N] [--group N]\n"
+                  << "                     [--payloads file] [--json file]" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,120 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief "LogStructuredDatabase" in action: the same "BusinessLogic" from "main.cpp" now persists its records to local files,
+ *        and survives a crash.
+ *
+ *        1) Crash recovery: we write records, take a copy of the database directory while the database is still open
+ *           (quiesced, so that no flush or compaction changes the files under the copy), tear the last WAL record in half, and
+ *           open the copy.
+ *           Every record must be there and the torn tail must be discarded.
+ *        2) Write throughput for each fsync policy, with and without group commit, and the recovery time of a full database.
+ *
+ *        "BusinessLogic" logs every record to stdout, so run it with stdout redirected and read the results on stderr:
+ *            g++ -std=c++20 -O2 -pthread "Log Structured Storage.cpp" -o LogStructuredStorage
+ *            ./LogStructuredStorage > /dev/null
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+
+#include "LogStructuredDatabase.hpp"
+
+
+namespace fs = std::filesystem;
+
+// Copies what is on disk right now.
+static void snapshotDirectory(const fs::path& from, const fs::path& to) {
+    fs::remove_all(to);
+    fs::create_directories(to);
+    for (const auto& file : fs::directory_iterator(from)) fs::copy_file(file.path(), to / file.path().filename());
+}
+
+static bool crashRecoveryCheck() {
+    const fs::path live = "lsm_live";
+    const fs::path crashed = "lsm_crashed";
+    fs::remove_all(live);
+
+    const int keys = 5000;
+    LogStructuredOptions options{live, FsyncPolicy::Always, std::chrono::milliseconds(0), 32 * 1024, 3};
+    LogStructuredDatabase database(options);
+    {
+        BusinessLogic businessLogic(&database, GroupCommitPolicy{64, std::chrono::milliseconds(5)});
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < keys; ++i) {
+                businessLogic.processData("user" + std::to_string(i) + "=v" + std::to_string(round));
+            }
+        }
+    }
+
+    // "Crash": keep the database open and take whatever is on disk, then tear the last WAL record in half.
+    database.quiesced([&] { snapshotDirectory(live, crashed); });
+    for (const auto& file : fs::directory_iterator(crashed)) {
+        if (file.path().extension() == ".log") {
+            std::FILE* wal = std::fopen(file.path().string().c_str(), "ab");
+            const char torn[] = {42, 0, 0, 0, 1, 2};   // A header whose record never made it to disk
+            std::fwrite(torn, 1, sizeof(torn), wal);
+            std::fclose(wal);
+        }
+    }
+
+    LogStructuredDatabase recovered(LogStructuredOptions{crashed});
+    int missing = 0;
+    for (int i = 0; i < keys; ++i) {
+        const std::string key = "user" + std::to_string(i);
+        if (recovered.loadData(key) != key + "=v2") ++missing;
+    }
+
+    auto stats = recovered.stats();
+    std::cerr << "Crash recovery: " << (keys - missing) << "/" << keys << " keys with their latest value, "
+              << stats.recoveredRecords << " records replayed from the WAL, " << stats.discardedBytes
+              << " torn bytes discarded, " << stats.segments << " segments, recovered in " << stats.recoverySeconds * 1000
+              << " ms" << std::endl;
+    return missing == 0 && stats.discardedBytes > 0;
+}
+
+static void writeThroughput(const char* name, FsyncPolicy policy, std::size_t groupSize, int records) {
+    const fs::path directory = "lsm_bench";
+    fs::remove_all(directory);
+    const std::string value(100, 'x');
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        LogStructuredDatabase database(LogStructuredOptions{directory, policy});
+        BusinessLogic businessLogic(&database, GroupCommitPolicy{groupSize, std::chrono::milliseconds(5)});
+        for (int i = 0; i < records; ++i) {
+            businessLogic.processData("key" + std::to_string(i) + "=" + value);
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    LogStructuredDatabase reopened(LogStructuredOptions{directory});
+    std::cerr << name << ": " << records / seconds << " records/s, " << records * (value.size() + 10) / seconds / (1024 * 1024)
+              << " MB/s, reopen in " << reopened.stats().recoverySeconds * 1000 << " ms ("
+              << reopened.stats().segments << " segments)" << std::endl;
+}
+
+int main() {
+    bool passed = crashRecoveryCheck();
+    std::cerr << "Crash recovery check: " << (passed ? "PASSED" : "FAILED") << std::endl;
+
+    writeThroughput("fsync never,    one record per call  ", FsyncPolicy::Never, 1, 300000);
+    writeThroughput("fsync interval, one record per call  ", FsyncPolicy::Interval, 1, 300000);
+    writeThroughput("fsync always,   one record per call  ", FsyncPolicy::Always, 1, 2000);
+    writeThroughput("fsync always,   256 records per group", FsyncPolicy::Always, 256, 300000);
+
+    fs::remove_all("lsm_live");
+    fs::remove_all("lsm_crashed");
+    fs::remove_all("lsm_bench");
+    return passed ? 0 : 1;
+}
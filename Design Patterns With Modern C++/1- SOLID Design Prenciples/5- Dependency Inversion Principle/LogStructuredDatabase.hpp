@@ -0,0 +1,636 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief LogStructuredDatabase: a real, embedded "DatabaseInterface" backend, no database server needed.
+ *
+ *        - Every record is first appended to a write-ahead log (WAL) file, then inserted into an in-memory sorted table (memtable).
+ *        - When the memtable grows past "memtableBytes" it is frozen, a new WAL is started, and a background thread writes the frozen
+ *          table to disk as a sorted, immutable segment file. The old WAL is deleted once its segment is safely on disk.
+ *        - When there are "compactionTrigger" segments, the background thread merges them into one (the newest value of a key wins).
+ *        - Opening the database recovers from a crash: complete segments are loaded, the remaining WAL files are replayed up to the
+ *          first torn record, and the replayed records are written to a segment right away, so recovery time is bounded by the
+ *          memtable size and not by the history of the database.
+ *
+ *        Records follow the "key=value" convention of "recordKey()" in "DatabaseInterface.hpp".
+ *
+ *        Thread safety: thread-safe, writers are serialized by one mutex (the WAL is a single file anyway).
+ *
+ *        A WAL write or fsync that fails leaves the WAL in an unknown state: every later write throws, reads still work. A background
+ *        flush or compaction that fails (disk full, I/O error) stops the background thread: every later write rethrows its
+ *        exception, reads still work (the frozen memtable stays in memory, its WAL on disk for the next recovery).
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <span>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <exception>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "DatabaseInterface.hpp"
+
+
+// When the WAL is forced to stable storage (the file is always handed to the OS after each call).
+enum class FsyncPolicy {
+    Always,     // fsync after every saveData()/saveBatch(): nothing is lost even if the machine crashes
+    Interval,   // fsync every "fsyncInterval" (the background thread does it if no write comes): a machine crash loses at most that much
+    Never       // leave it to the OS: only a process crash is survived
+};
+
+struct LogStructuredOptions {
+    std::filesystem::path directory;
+    FsyncPolicy fsync = FsyncPolicy::Interval;
+    std::chrono::milliseconds fsyncInterval{50};
+    std::size_t memtableBytes = 4 * 1024 * 1024;   // Freeze and flush the memtable past this size
+    std::size_t compactionTrigger = 4;             // Merge the segments once there are this many, at least 2
+};
+
+class LogStructuredDatabase : public DatabaseInterface {
+public:
+    struct Stats {
+        std::size_t segments = 0;
+        std::size_t memtableBytes = 0;
+        std::size_t flushes = 0;
+        std::size_t compactions = 0;
+        std::size_t recoveredRecords = 0;
+        std::size_t discardedBytes = 0;      // Torn WAL tail thrown away during recovery
+        double recoverySeconds = 0;
+    };
+
+    explicit LogStructuredDatabase(LogStructuredOptions options) : options_(std::move(options)) {
+        if (options_.compactionTrigger < 2) {   // One segment would be "compacted" into one segment forever
+            throw std::invalid_argument("LogStructuredDatabase: compactionTrigger must be at least 2");
+        }
+        recover();
+        background_ = std::thread([this] { backgroundLoop(); });
+    }
+
+    ~LogStructuredDatabase() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            if (wal_) syncFile(wal_);
+        }
+        backgroundCv_.notify_all();
+        background_.join();
+        if (wal_) std::fclose(wal_);
+    }
+
+    LogStructuredDatabase(const LogStructuredDatabase&) = delete;
+    LogStructuredDatabase& operator=(const LogStructuredDatabase&) = delete;
+
+    void saveData(const std::string& data) override {
+        std::string_view record = data;
+        saveBatch(std::span<const std::string_view>(&record, 1));
+    }
+
+    // The whole group costs one WAL write and at most one fsync.
+    void saveBatch(std::span<const std::string_view> records) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        checkWritable();
+        for (std::string_view r : records) {
+            if (!appendWal(wal_, r)) walFailed_ = true;
+        }
+        if (std::fflush(wal_) != 0) walFailed_ = true;
+        checkWal();
+        if (options_.fsync == FsyncPolicy::Always ||
+            (options_.fsync == FsyncPolicy::Interval && Clock::now() - lastSync_ >= options_.fsyncInterval)) {
+            if (!syncWal()) checkWal();
+        } else if (options_.fsync == FsyncPolicy::Interval && !walDirty_) {
+            walDirty_ = true;
+            backgroundCv_.notify_all();   // Starts the background thread's fsync timer
+        }
+
+        for (std::string_view r : records) insert(r);
+        if (memtableBytes_ >= options_.memtableBytes) rotate(lock);
+    }
+
+    // Forces the WAL to stable storage now, whatever the policy.
+    void sync() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        checkWritable();
+        if (!syncWal()) checkWal();
+    }
+
+    // Runs "f" while nothing changes on disk: writers are blocked and the background flush and compaction are paused (one that
+    // is running finishes first). For taking a consistent copy of the directory while the database stays open.
+    template <typename F>
+    void quiesced(F&& f) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        paused_ = true;
+        flushedCv_.wait(lock, [this] { return !backgroundBusy_; });
+        struct Resume {
+            LogStructuredDatabase& database;
+            ~Resume() {
+                database.paused_ = false;
+                database.backgroundCv_.notify_all();
+            }
+        } resume{*this};
+        f();
+    }
+
+    // Latest record saved under "key": memtable first, then the frozen memtable, then the segments from newest to oldest.
+    std::optional<std::string> loadData(std::string_view key) override {
+        std::vector<std::shared_ptr<Segment>> segments;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (auto it = memtable_.find(key); it != memtable_.end()) return it->second;
+            if (immutable_) {
+                if (auto it = immutable_->find(key); it != immutable_->end()) return it->second;
+            }
+            segments = segments_;
+        }
+        for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+            if (auto value = (*it)->get(key)) return value;
+        }
+        return std::nullopt;
+    }
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats s = stats_;
+        s.segments = segments_.size();
+        s.memtableBytes = memtableBytes_;
+        return s;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using Memtable = std::map<std::string, std::string, std::less<>>;
+
+    static constexpr std::uint32_t kSegmentMagic = 0x4C534D31; // "LSM1"
+
+    // Sorted, immutable file of "key -> record" entries with an in-memory index.
+    class Segment {
+    public:
+        struct Entry {
+            std::string key;
+            std::uint64_t offset;   // Where the record starts in the file
+            std::uint32_t size;
+        };
+
+        Segment(std::uint64_t generation, std::uint64_t sequence, std::filesystem::path path, std::vector<Entry> index)
+            : generation_(generation), sequence_(sequence), path_(std::move(path)), index_(std::move(index)),
+              file_(std::fopen(path_.string().c_str(), "rb")) {}
+
+        // A compacted segment is deleted once the last reader let go of it.
+        ~Segment() {
+            if (file_) std::fclose(file_);
+            if (obsolete_) {
+                std::error_code ignored;
+                std::filesystem::remove(path_, ignored);
+            }
+        }
+
+        std::uint64_t generation() const { return generation_; }
+        std::uint64_t sequence() const { return sequence_; }
+        void markObsolete() { obsolete_ = true; }
+
+        // Segments are ordered by generation, then by how many times they were compacted.
+        bool olderThan(const Segment& other) const {
+            return generation_ != other.generation_ ? generation_ < other.generation_ : sequence_ < other.sequence_;
+        }
+
+        const std::filesystem::path& path() const { return path_; }
+        const std::vector<Entry>& index() const { return index_; }
+
+        std::optional<std::string> get(std::string_view key) const {
+            auto it = std::lower_bound(index_.begin(), index_.end(), key,
+                                       [](const Entry& e, std::string_view k) { return e.key < k; });
+            if (it == index_.end() || it->key != key) return std::nullopt;
+            return read(*it);
+        }
+
+        std::string read(const Entry& entry) const {
+            std::string record(entry.size, '\0');
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::fseek(file_, static_cast<long>(entry.offset), SEEK_SET);
+            if (std::fread(record.data(), 1, record.size(), file_) != record.size()) {
+                throw std::runtime_error("LogStructuredDatabase: short read in " + path_.string());
+            }
+            return record;
+        }
+
+    private:
+        std::uint64_t generation_;
+        std::uint64_t sequence_;
+        std::filesystem::path path_;
+        std::vector<Entry> index_;
+        mutable std::mutex mutex_;
+        std::FILE* file_;
+        std::atomic<bool> obsolete_{false};
+    };
+
+    // ---- File helpers -------------------------------------------------------------------------
+
+    static std::uint32_t checksum(std::string_view bytes, std::uint32_t hash = 2166136261u) {
+        for (unsigned char c : bytes) hash = (hash ^ c) * 16777619u; // FNV-1a
+        return hash;
+    }
+
+    static void putU32(std::string& out, std::uint32_t v) {
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+    }
+
+    static void putU64(std::string& out, std::uint64_t v) {
+        for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+    }
+
+    static std::uint64_t getLE(const unsigned char* p, int bytes) {
+        std::uint64_t v = 0;
+        for (int i = 0; i < bytes; ++i) v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+        return v;
+    }
+
+    static bool syncFile(std::FILE* f) {
+        if (std::fflush(f) != 0) return false;
+#ifdef _WIN32
+        return _commit(_fileno(f)) == 0;
+#else
+        return fsync(fileno(f)) == 0;
+#endif
+    }
+
+    // A new, renamed or deleted file is only durable once its directory is: fsync the directory itself.
+    bool syncDirectory() const {
+#ifdef _WIN32
+        return true;   // No portable way to open a directory for syncing, NTFS journals the metadata
+#else
+        const int fd = ::open(options_.directory.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        const bool synced = fsync(fd) == 0;
+        ::close(fd);
+        return synced;
+#endif
+    }
+
+    static bool writeAll(std::FILE* f, std::string_view bytes) {
+        return std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    }
+
+    static std::string readFile(const std::filesystem::path& path) {
+        std::string bytes(std::filesystem::file_size(path), '\0');
+        std::FILE* f = std::fopen(path.string().c_str(), "rb");
+        if (!f) throw std::runtime_error("LogStructuredDatabase: cannot open " + path.string());
+        std::size_t read = std::fread(bytes.data(), 1, bytes.size(), f);
+        std::fclose(f);
+        bytes.resize(read);
+        return bytes;
+    }
+
+    std::filesystem::path walPath(std::uint64_t generation) const {
+        return options_.directory / ("wal-" + std::to_string(generation) + ".log");
+    }
+
+    std::filesystem::path segmentPath(std::uint64_t generation, std::uint64_t sequence) const {
+        return options_.directory / ("segment-" + std::to_string(generation) + "-" + std::to_string(sequence) + ".sst");
+    }
+
+    // Parses "<prefix><n>[-<m>]<extension>", e.g. "wal-7.log" or "segment-7-2.sst".
+    static std::optional<std::pair<std::uint64_t, std::uint64_t>> parseName(const std::filesystem::path& path,
+                                                                           std::string_view prefix,
+                                                                           std::string_view extension) {
+        const std::string name = path.filename().string();
+        if (name.rfind(prefix, 0) != 0 || path.extension() != extension) return std::nullopt;
+        try {
+            std::size_t used = 0;
+            const std::string rest = name.substr(prefix.size());
+            const std::uint64_t first = std::stoull(rest, &used);
+            const std::uint64_t second = rest[used] == '-' ? std::stoull(rest.substr(used + 1)) : 0;
+            return std::make_pair(first, second);
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    }
+
+    // WAL record: [size:u32][checksum:u32][record bytes]
+    static bool appendWal(std::FILE* wal, std::string_view record) {
+        std::string header;
+        putU32(header, static_cast<std::uint32_t>(record.size()));
+        putU32(header, checksum(record));
+        return writeAll(wal, header) && writeAll(wal, record);
+    }
+
+    // Replays a WAL into "table" and returns how many bytes of torn tail were discarded.
+    std::size_t replayWal(const std::filesystem::path& path, Memtable& table, std::size_t& records) {
+        const std::string bytes = readFile(path);
+        const auto* p = reinterpret_cast<const unsigned char*>(bytes.data());
+        std::size_t pos = 0;
+        while (pos + 8 <= bytes.size()) {
+            const std::size_t size = getLE(p + pos, 4);
+            const auto expected = static_cast<std::uint32_t>(getLE(p + pos + 4, 4));
+            if (pos + 8 + size > bytes.size()) break;
+            std::string_view record(bytes.data() + pos + 8, size);
+            if (checksum(record) != expected) break;
+            table.insert_or_assign(std::string(recordKey(record)), std::string(record));
+            ++records;
+            pos += 8 + size;
+        }
+        return bytes.size() - pos;
+    }
+
+    // Segment file: entries [keySize:u32][recordSize:u32][key][record] ..., then the footer [count:u64][checksum:u32][magic:u32].
+    // It is written to a temporary file and renamed, so a crash never leaves a half-written segment behind.
+    template <typename Entries>
+    std::shared_ptr<Segment> writeSegment(std::uint64_t generation, std::uint64_t sequence, const Entries& entries) {
+        const auto path = segmentPath(generation, sequence);
+        const auto tmp = std::filesystem::path(path).concat(".tmp");
+        std::FILE* f = std::fopen(tmp.string().c_str(), "wb");
+        if (!f) throw std::runtime_error("LogStructuredDatabase: cannot create " + tmp.string());
+
+        std::vector<Segment::Entry> index;
+        std::uint32_t sum = 2166136261u;
+        std::uint64_t offset = 0;
+        std::string header;
+        bool written = true;
+        for (const auto& [key, record] : entries) {
+            header.clear();
+            putU32(header, static_cast<std::uint32_t>(key.size()));
+            putU32(header, static_cast<std::uint32_t>(record.size()));
+            written = written && writeAll(f, header) && writeAll(f, key) && writeAll(f, record);
+            sum = checksum(record, checksum(key, checksum(header, sum)));
+            offset += header.size() + key.size();
+            index.push_back({std::string(key), offset, static_cast<std::uint32_t>(record.size())});
+            offset += record.size();
+        }
+
+        std::string footer;
+        putU64(footer, index.size());
+        putU32(footer, sum);
+        putU32(footer, kSegmentMagic);
+        written = written && writeAll(f, footer) && syncFile(f);
+        if (std::fclose(f) != 0 || !written) {
+            std::error_code ignored;
+            std::filesystem::remove(tmp, ignored);
+            throw std::runtime_error("LogStructuredDatabase: cannot write " + tmp.string());
+        }
+        std::filesystem::rename(tmp, path);
+        if (!syncDirectory()) throw std::runtime_error("LogStructuredDatabase: cannot sync " + options_.directory.string());
+        return std::make_shared<Segment>(generation, sequence, path, std::move(index));
+    }
+
+    // Returns nullptr if the segment is not complete (it then never made it past its temporary name).
+    static std::shared_ptr<Segment> loadSegment(std::uint64_t generation, std::uint64_t sequence,
+                                                const std::filesystem::path& path) {
+        const std::string bytes = readFile(path);
+        if (bytes.size() < 16) return nullptr;
+        const auto* p = reinterpret_cast<const unsigned char*>(bytes.data());
+        const std::size_t body = bytes.size() - 16;
+        const std::uint64_t count = getLE(p + body, 8);
+        const auto sum = static_cast<std::uint32_t>(getLE(p + body + 8, 4));
+        if (getLE(p + body + 12, 4) != kSegmentMagic || checksum(std::string_view(bytes.data(), body)) != sum) return nullptr;
+
+        std::vector<Segment::Entry> index;
+        index.reserve(count);
+        std::size_t pos = 0;
+        while (pos + 8 <= body) {
+            const std::size_t keySize = getLE(p + pos, 4);
+            const std::size_t recordSize = getLE(p + pos + 4, 4);
+            index.push_back({std::string(bytes.data() + pos + 8, keySize), pos + 8 + keySize,
+                             static_cast<std::uint32_t>(recordSize)});
+            pos += 8 + keySize + recordSize;
+        }
+        return std::make_shared<Segment>(generation, sequence, path, std::move(index));
+    }
+
+    // ---- Recovery -----------------------------------------------------------------------------
+
+    void recover() {
+        const auto start = Clock::now();
+        std::filesystem::create_directories(options_.directory);
+
+        std::vector<std::pair<std::uint64_t, std::filesystem::path>> wals;
+        std::uint64_t maxGeneration = 0;
+        for (const auto& file : std::filesystem::directory_iterator(options_.directory)) {
+            const auto& path = file.path();
+            if (path.extension() == ".tmp") {
+                std::filesystem::remove(path); // A flush or compaction that did not finish
+            } else if (auto name = parseName(path, "segment-", ".sst")) {
+                if (auto segment = loadSegment(name->first, name->second, path)) segments_.push_back(std::move(segment));
+                maxGeneration = std::max(maxGeneration, name->first);
+            } else if (auto name = parseName(path, "wal-", ".log")) {
+                wals.emplace_back(name->first, path);
+                maxGeneration = std::max(maxGeneration, name->first);
+            }
+        }
+        // Inputs of a compaction that crashed before deleting them are harmless: the compacted copy is newer and wins.
+        std::sort(segments_.begin(), segments_.end(), [](const auto& a, const auto& b) { return a->olderThan(*b); });
+        std::sort(wals.begin(), wals.end());
+
+        // Replay every WAL whose memtable never reached a segment, then persist them as one segment right away.
+        Memtable replayed;
+        std::uint64_t replayedGeneration = 0;
+        for (const auto& [generation, path] : wals) {
+            const bool flushed = std::any_of(segments_.begin(), segments_.end(),
+                                             [g = generation](const auto& s) { return s->generation() == g; });
+            if (!flushed) {
+                stats_.discardedBytes += replayWal(path, replayed, stats_.recoveredRecords);
+                replayedGeneration = generation;
+            }
+        }
+        if (!replayed.empty()) {
+            segments_.push_back(writeSegment(replayedGeneration, 0, replayed));
+        }
+        for (const auto& wal : wals) std::filesystem::remove(wal.second);
+
+        generation_ = maxGeneration + 1;
+        openWal();
+        stats_.recoverySeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    void openWal() {
+        wal_ = std::fopen(walPath(generation_).string().c_str(), "ab");
+        if (!wal_) throw std::runtime_error("LogStructuredDatabase: cannot open " + walPath(generation_).string());
+        if (!syncDirectory()) throw std::runtime_error("LogStructuredDatabase: cannot sync " + options_.directory.string());
+        lastSync_ = Clock::now();
+        walDirty_ = false;
+    }
+
+    // Forces the WAL to stable storage, false (and every later write throws) if it failed.
+    bool syncWal() {
+        if (!syncFile(wal_)) {
+            walFailed_ = true;
+            return false;
+        }
+        lastSync_ = Clock::now();
+        walDirty_ = false;
+        return true;
+    }
+
+    void checkWal() const {
+        if (walFailed_) throw std::runtime_error("LogStructuredDatabase: cannot write the WAL in " + options_.directory.string());
+    }
+
+    // The WAL, and the background thread's first failure: both are sticky.
+    void checkWritable() const {
+        if (backgroundFailure_) std::rethrow_exception(backgroundFailure_);
+        checkWal();
+    }
+
+    bool intervalSyncPending() const { return options_.fsync == FsyncPolicy::Interval && walDirty_; }
+
+    // ---- Write path ---------------------------------------------------------------------------
+
+    void insert(std::string_view record) {
+        auto [it, inserted] = memtable_.insert_or_assign(std::string(recordKey(record)), std::string(record));
+        memtableBytes_ += record.size() + (inserted ? it->first.size() : 0);
+    }
+
+    // Freezes the memtable and starts a new WAL. If the previous frozen memtable is still being written,
+    // the writer waits for it (write stall) so memory stays bounded to two memtables.
+    void rotate(std::unique_lock<std::mutex>& lock) {
+        flushedCv_.wait(lock, [this] { return !immutable_ || backgroundFailure_; });
+        checkWritable();   // The frozen memtable will never be written: do not freeze a second one
+        if (!syncWal()) checkWal();
+        std::fclose(wal_);
+
+        immutable_ = std::make_shared<const Memtable>(std::move(memtable_));
+        immutableGeneration_ = generation_;
+        memtable_.clear();
+        memtableBytes_ = 0;
+
+        ++generation_;
+        openWal();
+        backgroundCv_.notify_all();
+    }
+
+    // ---- Background flush, compaction and interval fsync --------------------------------------
+
+    void backgroundLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            const auto ready = [this] {
+                return stop_ || (!paused_ && !backgroundFailure_ && (immutable_ || segments_.size() >= options_.compactionTrigger));
+            };
+            if (intervalSyncPending()) {
+                backgroundCv_.wait_until(lock, lastSync_ + options_.fsyncInterval, ready);
+            } else {
+                backgroundCv_.wait(lock, [&] { return ready() || intervalSyncPending(); });
+            }
+
+            // The last write of a burst is synced within the interval even if no other write comes to do it.
+            if (intervalSyncPending() && Clock::now() - lastSync_ >= options_.fsyncInterval) syncWal();
+
+            if (!paused_ && !backgroundFailure_ && immutable_) {
+                auto table = immutable_;
+                const std::uint64_t generation = immutableGeneration_;
+                backgroundBusy_ = true;
+                lock.unlock();
+                std::shared_ptr<Segment> segment;
+                std::exception_ptr failure;
+                try {
+                    segment = writeSegment(generation, 0, *table);
+                    std::filesystem::remove(walPath(generation));
+                    syncDirectory();   // Not needed for safety: a WAL whose segment exists is skipped by recovery
+                } catch (...) {
+                    failure = std::current_exception();
+                }
+                lock.lock();
+                if (segment) {   // On disk even if removing the WAL failed: recovery skips that WAL
+                    segments_.push_back(std::move(segment));
+                    immutable_.reset();
+                    ++stats_.flushes;
+                }
+                backgroundFailure_ = failure;
+                backgroundBusy_ = false;
+                flushedCv_.notify_all();
+            } else if (!paused_ && !backgroundFailure_ && segments_.size() >= options_.compactionTrigger) {
+                auto inputs = segments_; // Only this thread adds or removes segments
+                backgroundBusy_ = true;
+                lock.unlock();
+                std::shared_ptr<Segment> merged;
+                std::exception_ptr failure;
+                try {
+                    merged = mergeSegments(inputs);
+                } catch (...) {
+                    failure = std::current_exception();
+                }
+                lock.lock();
+                if (merged) {
+                    segments_.assign(1, std::move(merged));
+                    ++stats_.compactions;
+                }
+                backgroundFailure_ = failure;
+                backgroundBusy_ = false;
+                flushedCv_.notify_all();
+            } else if (stop_) {
+                return;
+            }
+        }
+    }
+
+    // Merges "inputs" (oldest first) into one segment that sorts right after the newest input.
+    // The inputs are deleted once no reader uses them anymore.
+    std::shared_ptr<Segment> mergeSegments(const std::vector<std::shared_ptr<Segment>>& inputs) {
+        std::map<std::string_view, std::pair<const Segment*, const Segment::Entry*>> newest;
+        for (auto it = inputs.rbegin(); it != inputs.rend(); ++it) {
+            for (const auto& entry : (*it)->index()) newest.try_emplace(entry.key, it->get(), &entry);
+        }
+
+        struct Entries {
+            const decltype(newest)& source;
+            struct Iterator {
+                typename decltype(newest)::const_iterator it;
+                std::pair<std::string_view, std::string> operator*() const {
+                    return {it->first, it->second.first->read(*it->second.second)};
+                }
+                Iterator& operator++() { ++it; return *this; }
+                bool operator!=(const Iterator& other) const { return it != other.it; }
+            };
+            Iterator begin() const { return {source.begin()}; }
+            Iterator end() const { return {source.end()}; }
+        };
+
+        auto merged = writeSegment(inputs.back()->generation(), inputs.back()->sequence() + 1, Entries{newest});
+        for (const auto& input : inputs) input->markObsolete();
+        return merged;
+    }
+
+    LogStructuredOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable backgroundCv_;
+    std::condition_variable flushedCv_;
+    Memtable memtable_;
+    std::size_t memtableBytes_ = 0;
+    std::shared_ptr<const Memtable> immutable_;
+    std::uint64_t immutableGeneration_ = 0;
+    std::vector<std::shared_ptr<Segment>> segments_;   // Oldest first
+    std::uint64_t generation_ = 1;
+    std::FILE* wal_ = nullptr;
+    Clock::time_point lastSync_;
+    bool walDirty_ = false;        // Written since the last fsync (Interval policy only)
+    bool walFailed_ = false;
+    std::exception_ptr backgroundFailure_;   // First exception of a background flush or compaction
+    Stats stats_;
+    bool stop_ = false;
+    bool paused_ = false;          // quiesced() is running
+    bool backgroundBusy_ = false;  // A flush or compaction is writing files, without the lock
+    std::thread background_;
+};
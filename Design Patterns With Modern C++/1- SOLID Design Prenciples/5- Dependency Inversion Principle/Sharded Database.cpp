@@ -0,0 +1,171 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief "ShardedDatabase" with in-process children ("StripedMemoryDatabase"):
+ *
+ *        1) Key movement: how many keys change owner when a 5th child joins 4, with consistent hashing and with "hash % N".
+ *        2) Every record is still found after adding and removing children, and a record overwritten while a child was in the
+ *           layout reads back as the new one after that child is removed (and after it is added back).
+ *        3) saveBatch() throughput with 1, 2, 4 and 8 remote children (a round trip per call plus a cost per record), with the
+ *           parallel fan-out and with the groups saved one after the other. Per-child load statistics for 4 children.
+ *
+ *        Build: g++ -std=c++20 -O2 -pthread "Sharded Database.cpp" -o ShardedDatabase
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <memory>
+#include <functional>
+
+#include "ShardedDatabase.hpp"
+#include "StripedMemoryDatabase.hpp"
+
+
+// A child on the other side of the network: 1 ms round trip per call, plus 5 us per record it has to store.
+class RemoteDatabase : public DatabaseInterface {
+public:
+    void saveData(const std::string& data) override {
+        std::this_thread::sleep_for(std::chrono::microseconds(1005));
+        storage_.saveData(data);
+    }
+
+    void saveBatch(std::span<const std::string_view> records) override {
+        std::this_thread::sleep_for(std::chrono::microseconds(1000 + 5 * records.size()));
+        storage_.saveBatch(records);
+    }
+
+    std::optional<std::string> loadData(std::string_view key) override {
+        return storage_.loadData(key);
+    }
+
+private:
+    StripedMemoryDatabase storage_{8};
+};
+
+static void printStats(const ShardedDatabase& database) {
+    for (const auto& s : database.stats()) {
+        std::cout << "    " << s.name << ": " << s.records << " records, " << s.bytes / 1024 << " KB, " << s.batches
+                  << " batches, owns " << s.ownership * 100 << "% of the keys" << std::endl;
+    }
+}
+
+static void keyMovement(int keys) {
+    std::vector<std::unique_ptr<StripedMemoryDatabase>> children;
+    ShardedDatabase database;
+    for (int i = 0; i < 4; ++i) {
+        children.push_back(std::make_unique<StripedMemoryDatabase>());
+        database.addShard("shard" + std::to_string(i), *children.back());
+    }
+
+    std::vector<std::string> before;
+    for (int k = 0; k < keys; ++k) before.push_back(database.ownerOf("key" + std::to_string(k)));
+
+    children.push_back(std::make_unique<StripedMemoryDatabase>());
+    database.addShard("shard4", *children.back());
+
+    int moved = 0, movedModulo = 0;
+    for (int k = 0; k < keys; ++k) {
+        const std::string key = "key" + std::to_string(k);
+        moved += database.ownerOf(key) != before[k];
+        const std::size_t h = std::hash<std::string>{}(key);
+        movedModulo += h % 4 != h % 5;
+    }
+    std::cout << "Adding a 5th child to 4 moves " << 100.0 * moved / keys << "% of the keys (ideal: 20%), hash % N moves "
+              << 100.0 * movedModulo / keys << "%" << std::endl;
+    printStats(database);
+}
+
+static bool everyRecordFound(int keys) {
+    std::vector<std::unique_ptr<StripedMemoryDatabase>> children;
+    auto newChild = [&]() -> DatabaseInterface& {
+        children.push_back(std::make_unique<StripedMemoryDatabase>());
+        return *children.back();
+    };
+
+    ShardedDatabase database;
+    database.addShard("a", newChild());
+    database.addShard("b", newChild());
+    for (int k = 0; k < keys; ++k) database.saveData("key" + std::to_string(k) + "=v" + std::to_string(k));
+
+    database.addShard("c", newChild());
+    database.removeShard("a");
+    database.addShard("d", newChild());
+
+    int found = 0;
+    for (int k = 0; k < keys; ++k) {
+        found += database.loadData("key" + std::to_string(k)) == "key" + std::to_string(k) + "=v" + std::to_string(k);
+    }
+    std::cout << "After adding c, removing a and adding d: " << found << "/" << keys << " records found" << std::endl;
+    return found == keys;
+}
+
+// Written under {a, c}, overwritten once b joined (some keys land on b), then b leaves: a and c still hold the first records.
+static bool newestRecordFound(int keys) {
+    StripedMemoryDatabase a, b, c;
+    ShardedDatabase database;
+    database.addShard("a", a);
+    database.addShard("c", c);
+    for (int k = 0; k < keys; ++k) database.saveData("key" + std::to_string(k) + "=v1");
+    database.addShard("b", b);
+    for (int k = 0; k < keys; ++k) database.saveData("key" + std::to_string(k) + "=v2");
+
+    auto newest = [&] {
+        int found = 0;
+        for (int k = 0; k < keys; ++k) found += database.loadData("key" + std::to_string(k)) == "key" + std::to_string(k) + "=v2";
+        return found;
+    };
+    database.removeShard("b");
+    const int afterRemove = newest();
+    database.addShard("b", b);
+    const int afterReadd = newest();
+    std::cout << "Overwritten with b in, then b removed: " << afterRemove << "/" << keys << " newest records found, "
+              << afterReadd << "/" << keys << " once b is back" << std::endl;
+    return afterRemove == keys && afterReadd == keys;
+}
+
+static void batchThroughput(int shards, bool parallel, int batches, int batchSize) {
+    std::vector<std::unique_ptr<RemoteDatabase>> children;
+    ShardedDatabase database(128, parallel);
+    for (int i = 0; i < shards; ++i) {
+        children.push_back(std::make_unique<RemoteDatabase>());
+        database.addShard("shard" + std::to_string(i), *children.back());
+    }
+
+    std::vector<std::string> records;
+    for (int i = 0; i < batches * batchSize; ++i) records.push_back("key" + std::to_string(i) + "=" + std::string(64, 'x'));
+    std::vector<std::string_view> views(records.begin(), records.end());
+
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < batches; ++b) database.saveBatch(std::span<const std::string_view>(views).subspan(b * batchSize, batchSize));
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << shards << " children, " << (parallel ? "parallel  " : "sequential") << ": " << batches * batchSize / seconds << " records/s, " << seconds * 1000 / batches
+              << " ms per batch" << std::endl;
+    if (shards == 4 && parallel) printStats(database);
+}
+
+int main() {
+    keyMovement(100000);
+    bool passed = everyRecordFound(100000);
+    passed = newestRecordFound(1000) && passed;
+
+    for (int shards : {1, 2, 4, 8}) {
+        batchThroughput(shards, false, 200, 1024);
+        batchThroughput(shards, true, 200, 1024);
+    }
+
+    std::cout << "Lookup check: " << (passed ? "PASSED" : "FAILED") << std::endl;
+
+    getchar();
+    return passed ? 0 : 1;
+}
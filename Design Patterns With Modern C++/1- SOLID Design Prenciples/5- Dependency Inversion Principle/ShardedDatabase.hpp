@@ -0,0 +1,373 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief ShardedDatabase: one "DatabaseInterface" in front of N child backends, so the write throughput is no longer capped by one.
+ *
+ *        Every record goes to the child that owns its key (see recordKey()), chosen by consistent hashing: each child is placed at
+ *        "virtualNodes" pseudo-random points on a 64-bit ring, and a key belongs to the first point at or after its hash.
+ *        Adding or removing a child only moves the keys of the arcs it gains or loses (about 1/N of them), where "hash % N" would
+ *        move almost all of them.
+ *
+ *        - saveBatch() splits the batch per child and hands the groups to the children in parallel: each child has a worker thread
+ *          of its own for as long as it is in a layout, and the calling thread saves one of the groups meanwhile.
+ *        - Records are not copied between children when the layout changes. Instead the old layouts are kept, and so is the layout
+ *          each key was last written in since the first change: loadData() asks the owner in that layout, the one child holding
+ *          the newest copy (a key not written since is asked from its owner before the first change). The current owner alone
+ *          would not do: after a child is removed, its keys go back to children that may still hold their older records. Once the
+ *          old records were copied or expired, retireOldLayouts() drops the old layouts and the keys written meanwhile (that
+ *          memory grows with the keys written while old layouts are kept).
+ *        - stats() gives, per child: records, bytes, batches, and the share of the ring (of the keys) it owns.
+ *
+ *        Thread safety: thread-safe if every child is. With single-threaded children, call it from one thread only:
+ *        saveBatch() never calls the same child from two threads.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <atomic>
+#include <memory>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <condition_variable>
+
+#include "DatabaseInterface.hpp"
+
+
+struct ShardStats {
+    std::string name;
+    std::uint64_t records = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t batches = 0;   // saveBatch() calls this child received
+    double ownership = 0;        // Fraction of the ring, i.e. of the keys, this child owns
+};
+
+class ShardedDatabase : public DatabaseInterface {
+public:
+    // "parallelBatches = false" saves the groups of a batch one child after the other, on the calling thread.
+    explicit ShardedDatabase(std::size_t virtualNodes = 128, bool parallelBatches = true)
+        : virtualNodes_(virtualNodes), parallelBatches_(parallelBatches), current_(std::make_shared<Layout>()) {
+        if (virtualNodes_ == 0) throw std::invalid_argument("ShardedDatabase: virtualNodes must be at least 1");
+    }
+
+    // The child is not owned, it must outlive the ShardedDatabase (or at least retireOldLayouts() after removeShard()).
+    void addShard(std::string name, DatabaseInterface& backend) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (findShard(*current_, name)) throw std::invalid_argument("ShardedDatabase: shard " + name + " already exists");
+
+        auto shard = std::make_shared<Shard>();
+        shard->name = std::move(name);
+        shard->backend = &backend;
+        if (parallelBatches_) shard->worker = std::make_unique<Worker>(*shard);
+        std::vector<std::shared_ptr<Shard>> shards = current_->shards;
+        shards.push_back(std::move(shard));
+        replaceLayout(std::move(shards));
+    }
+
+    bool removeShard(std::string_view name) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        std::vector<std::shared_ptr<Shard>> shards = current_->shards;
+        auto it = std::find_if(shards.begin(), shards.end(), [&](const auto& s) { return s->name == name; });
+        if (it == shards.end()) return false;
+        shards.erase(it);
+        replaceLayout(std::move(shards));
+        return true;
+    }
+
+    // Forgets the layouts before the current one, loadData() then only asks the current owner of a key.
+    void retireOldLayouts() {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        old_.clear();
+        std::lock_guard<std::mutex> writtenLock(writtenMutex_);
+        written_.clear();
+    }
+
+    // Name of the child that owns "key" in the current layout.
+    std::string ownerOf(std::string_view key) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return owner(*current_, hashKey(key)).name;
+    }
+
+    void saveData(const std::string& data) override {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        Shard& shard = owner(*current_, hashKey(recordKey(data)));
+        shard.backend->saveData(data);
+        if (!old_.empty()) {
+            std::lock_guard<std::mutex> writtenLock(writtenMutex_);
+            remember(recordKey(data));
+        }
+        shard.records.fetch_add(1, std::memory_order_relaxed);
+        shard.bytes.fetch_add(data.size(), std::memory_order_relaxed);
+    }
+
+    void saveBatch(std::span<const std::string_view> records) override {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        const Layout& layout = *current_;
+        if (layout.ring.empty()) throw std::logic_error("ShardedDatabase: no shards");
+
+        std::vector<std::vector<std::string_view>> groups(layout.shards.size());
+        for (std::string_view r : records) groups[ownerIndex(layout, hashKey(recordKey(r)))].push_back(r);
+
+        // Every child but the first gets its group through its worker, the first one is saved on the calling thread meanwhile.
+        Fanout fanout;
+        std::size_t inlineGroup = groups.size();
+        for (std::size_t i = 0; i < groups.size(); ++i) {
+            if (groups[i].empty()) continue;
+            if (inlineGroup == groups.size()) inlineGroup = i;
+            else if (!parallelBatches_) saveGroup(*layout.shards[i], groups[i]);
+            else layout.shards[i]->worker->post(groups[i], fanout);
+        }
+        std::exception_ptr failure;
+        if (inlineGroup != groups.size()) {
+            try {
+                saveGroup(*layout.shards[inlineGroup], groups[inlineGroup]);
+            } catch (...) {
+                failure = std::current_exception();
+            }
+        }
+        std::exception_ptr workerFailure = fanout.wait();   // The groups live on this stack: wait even if the inline one failed
+        if (!old_.empty()) {   // The groups that failed too: their child may hold the record, or not, or an older one
+            std::lock_guard<std::mutex> writtenLock(writtenMutex_);
+            for (std::string_view r : records) remember(recordKey(r));
+        }
+        if (failure) std::rethrow_exception(failure);
+        if (workerFailure) std::rethrow_exception(workerFailure);
+    }
+
+    std::optional<std::string> loadData(std::string_view key) override {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        if (current_->ring.empty()) return std::nullopt;
+
+        // The layout the key was last written in: the current one, the one before the first change kept, or one in between.
+        const Layout* layout = current_.get();
+        if (!old_.empty()) {
+            std::lock_guard<std::mutex> writtenLock(writtenMutex_);
+            auto it = written_.find(key);
+            layout = it == written_.end() ? old_.front().get() : &layoutNumber(it->second);
+        }
+        return owner(*layout, hashKey(key)).backend->loadData(key);
+    }
+
+    std::vector<ShardStats> stats() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        std::vector<ShardStats> result;
+        for (std::size_t i = 0; i < current_->shards.size(); ++i) {
+            const Shard& shard = *current_->shards[i];
+            result.push_back({shard.name, shard.records.load(std::memory_order_relaxed), shard.bytes.load(std::memory_order_relaxed),
+                              shard.batches.load(std::memory_order_relaxed), current_->ownership[i]});
+        }
+        return result;
+    }
+
+private:
+    class Worker;
+
+    struct alignas(64) Shard {
+        std::string name;
+        DatabaseInterface* backend = nullptr;
+        std::atomic<std::uint64_t> records{0};
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::uint64_t> batches{0};
+        std::unique_ptr<Worker> worker;   // With parallelBatches only, stopped when the last layout holding the child is gone
+    };
+
+    // The groups of one saveBatch() still being saved by the workers, and the first failure among them.
+    struct Fanout {
+        std::mutex mutex;
+        std::condition_variable done;
+        std::size_t pending = 0;
+        std::exception_ptr failure;
+
+        void started() {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++pending;
+        }
+
+        // Notifies under the lock: the waiter cannot return, and destroy the Fanout, before this is done with it.
+        void finished(std::exception_ptr error) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (error && !failure) failure = error;
+            if (--pending == 0) done.notify_all();
+        }
+
+        std::exception_ptr wait() {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this] { return pending == 0; });
+            return failure;
+        }
+    };
+
+    // A child's own thread: saves the groups handed to it in order, so a single-threaded child is still only called by one thread
+    // per saveBatch().
+    class Worker {
+    public:
+        explicit Worker(Shard& shard) : thread_([this, &shard] { run(shard); }) {}
+
+        ~Worker() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            wake_.notify_one();
+            thread_.join();
+        }
+
+        void post(std::span<const std::string_view> group, Fanout& fanout) {
+            fanout.started();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                jobs_.push_back({group, &fanout});
+            }
+            wake_.notify_one();
+        }
+
+    private:
+        struct Job {
+            std::span<const std::string_view> group;
+            Fanout* fanout;
+        };
+
+        void run(Shard& shard) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (;;) {
+                wake_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+                if (jobs_.empty()) return;
+                const Job job = jobs_.front();
+                jobs_.pop_front();
+                lock.unlock();
+                std::exception_ptr error;
+                try {
+                    saveGroup(shard, job.group);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                job.fanout->finished(error);
+                lock.lock();
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::deque<Job> jobs_;
+        bool stop_ = false;
+        std::thread thread_;   // Last: started once the rest is constructed
+    };
+
+    struct Point {
+        std::uint64_t hash;
+        std::uint32_t shard;   // Index in Layout::shards
+    };
+
+    // Immutable once built: a topology change builds a new one.
+    struct Layout {
+        std::uint64_t number = 0;         // Counts the layouts built so far
+        std::vector<std::shared_ptr<Shard>> shards;
+        std::vector<Point> ring;          // Sorted by hash
+        std::vector<double> ownership;    // Per shard
+    };
+
+    // FNV-1a, then the splitmix64 finalizer so that close keys ("key1", "key2") land far apart on the ring.
+    static std::uint64_t hashKey(std::string_view key) {
+        std::uint64_t h = 14695981039346656037ull;
+        for (unsigned char c : key) h = (h ^ c) * 1099511628211ull;
+        h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ull;
+        h ^= h >> 27; h *= 0x94d049bb133111ebull;
+        return h ^ (h >> 31);
+    }
+
+    static const Shard* findShard(const Layout& layout, std::string_view name) {
+        for (const auto& s : layout.shards) if (s->name == name) return s.get();
+        return nullptr;
+    }
+
+    // "layout.ring" must not be empty.
+    static std::size_t ownerIndex(const Layout& layout, std::uint64_t hash) {
+        auto it = std::lower_bound(layout.ring.begin(), layout.ring.end(), hash,
+                                   [](const Point& p, std::uint64_t h) { return p.hash < h; });
+        return (it == layout.ring.end() ? layout.ring.front() : *it).shard;   // Past the last point: wrap around
+    }
+
+    static Shard& owner(const Layout& layout, std::uint64_t hash) {
+        if (layout.ring.empty()) throw std::logic_error("ShardedDatabase: no shards");
+        return *layout.shards[ownerIndex(layout, hash)];
+    }
+
+    // Called with writtenMutex_ (and a lock on mutex_) held, while old layouts are kept.
+    void remember(std::string_view key) {
+        auto it = written_.find(key);
+        if (it == written_.end()) written_.emplace(std::string(key), current_->number);
+        else it->second = current_->number;
+    }
+
+    // Called with a lock on mutex_ held: the current layout or a kept one (the keys written in the others were forgotten).
+    const Layout& layoutNumber(std::uint64_t number) const {
+        if (current_->number == number) return *current_;
+        for (const auto& layout : old_) if (layout->number == number) return *layout;
+        throw std::logic_error("ShardedDatabase: layout no longer kept");
+    }
+
+    static void saveGroup(Shard& shard, std::span<const std::string_view> group) {
+        shard.backend->saveBatch(group);
+        std::uint64_t bytes = 0;
+        for (std::string_view r : group) bytes += r.size();
+        shard.records.fetch_add(group.size(), std::memory_order_relaxed);
+        shard.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        shard.batches.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Called with the unique lock held.
+    void replaceLayout(std::vector<std::shared_ptr<Shard>> shards) {
+        auto layout = std::make_shared<Layout>();
+        layout->number = current_->number + 1;
+        layout->shards = std::move(shards);
+        for (std::uint32_t s = 0; s < layout->shards.size(); ++s) {
+            for (std::size_t v = 0; v < virtualNodes_; ++v) {
+                layout->ring.push_back({hashKey(layout->shards[s]->name + "#" + std::to_string(v)), s});
+            }
+        }
+        std::sort(layout->ring.begin(), layout->ring.end(), [](const Point& a, const Point& b) { return a.hash < b.hash; });
+
+        // A point owns the arc between the previous point (excluded) and itself, the first point also owns the wrap-around arc.
+        layout->ownership.assign(layout->shards.size(), 0.0);
+        for (std::size_t i = 0; i < layout->ring.size(); ++i) {
+            const std::uint64_t from = i == 0 ? layout->ring.back().hash : layout->ring[i - 1].hash;
+            const std::uint64_t arc = layout->ring[i].hash - from;   // Wraps modulo 2^64 for the first point
+            layout->ownership[layout->ring[i].shard] += static_cast<double>(arc) / 18446744073709551616.0;
+        }
+        if (layout->shards.size() == 1) layout->ownership[0] = 1.0;   // A single point owns the full circle, "arc" would be 0
+
+        if (!current_->shards.empty()) old_.push_back(std::move(current_));
+        current_ = std::move(layout);
+    }
+
+    const std::size_t virtualNodes_;
+    const bool parallelBatches_;
+    mutable std::shared_mutex mutex_;
+    std::shared_ptr<Layout> current_;
+    std::vector<std::shared_ptr<Layout>> old_;   // Oldest first
+
+    struct KeyHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+    };
+
+    std::mutex writtenMutex_;
+    std::unordered_map<std::string, std::uint64_t, KeyHash, std::equal_to<>> written_;   // Key -> layout number, while old_ is not empty
+};
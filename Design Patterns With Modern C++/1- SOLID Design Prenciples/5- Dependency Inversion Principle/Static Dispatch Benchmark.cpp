@@ -0,0 +1,101 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Cost per record of the virtual call in "BusinessLogic" vs. the compile-time injected "BusinessLogic<Db>".
+ *
+ *        The backend does almost nothing (it counts records and bytes), so the difference is the dispatch itself:
+ *        an indirect call that cannot be inlined vs. a direct call the compiler folds into the loop.
+ *        "ingest()" is used instead of "processData()" so that the log line does not hide the difference.
+ *
+ *        Build: g++ -std=c++20 -O2 -pthread "Static Dispatch Benchmark.cpp" -o StaticDispatchBenchmark
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <chrono>
+#include <type_traits>
+
+#include "DatabaseInterface.hpp"
+
+
+// Backend fixed at build time: "final", so a call through CountingDatabase* needs no vtable.
+class CountingDatabase final : public DatabaseInterface {
+public:
+    void saveData(const std::string& data) override {
+        ++records_;
+        bytes_ += data.size();
+    }
+
+    std::size_t records() const { return records_; }
+    std::size_t bytes() const { return bytes_; }
+
+private:
+    std::size_t records_ = 0;
+    std::size_t bytes_ = 0;
+};
+
+// A backend that does not even derive from DatabaseInterface, the concept is all it needs.
+struct PlainCountingDatabase {
+    std::size_t records = 0;
+    std::size_t bytes = 0;
+
+    void saveData(const std::string& data) {
+        ++records;
+        bytes += data.size();
+    }
+
+    void saveBatch(std::span<const std::string_view> group) {
+        for (std::string_view r : group) {
+            ++records;
+            bytes += r.size();
+        }
+    }
+
+    std::optional<std::string> loadData(std::string_view) { return std::nullopt; }
+};
+
+static_assert(DatabaseBackend<PlainCountingDatabase>);
+
+template <typename Logic>
+static double nanosecondsPerRecord(Logic& logic, const std::string& record, long records) {
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < records; ++i) logic.ingest(record);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / records;
+}
+
+int main(int argc, char* argv[]) {
+    const long records = 200000000;
+    const std::string record = "key=value";
+
+    // Picked at run time, so the compiler cannot guess the dynamic type and devirtualize the call by itself.
+    CountingDatabase first, second;
+    DatabaseInterface* injected = argc > 1 && argv[1][0] == '2' ? static_cast<DatabaseInterface*>(&second) : &first;
+
+    BusinessLogic runtimeLogic(injected);
+    static_assert(std::is_same_v<decltype(runtimeLogic), BusinessLogic<DatabaseInterface>>);
+    double virtualCall = nanosecondsPerRecord(runtimeLogic, record, records);
+
+    CountingDatabase fixed;
+    BusinessLogic<CountingDatabase> finalLogic(&fixed);
+    double finalCall = nanosecondsPerRecord(finalLogic, record, records);
+
+    PlainCountingDatabase plain;
+    BusinessLogic<PlainCountingDatabase> plainLogic(&plain);
+    double plainCall = nanosecondsPerRecord(plainLogic, record, records);
+
+    std::cout << "BusinessLogic<DatabaseInterface>      : " << virtualCall << " ns/record" << std::endl;
+    std::cout << "BusinessLogic<CountingDatabase final> : " << finalCall << " ns/record" << std::endl;
+    std::cout << "BusinessLogic<PlainCountingDatabase>  : " << plainCall << " ns/record" << std::endl;
+    std::cout << "Saved: " << first.records() + second.records() << " / " << fixed.records() << " / " << plain.records
+              << " records" << std::endl;
+
+    getchar();
+    return 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief StripedMemoryDatabase: a thread-safe, in-memory "DatabaseInterface" for many request threads sharing one database.
+ *
+ *        One mutex around one hash map makes every thread wait for every other thread, even when they touch unrelated keys.
+ *        Here the keys are spread over "stripes" independent shards, each with its own lock and its own hash map, so two threads only
+ *        wait for each other when their keys hash to the same shard. Each shard sits on its own cache line, so taking one lock does not
+ *        slow down the neighbouring shards (false sharing).
+ *
+ *        With "stripes = 1" it is the classic single-mutex map, which is what the contention benchmark compares against.
+ *
+ *        Thread safety: thread-safe.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <memory>
+#include <optional>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "DatabaseInterface.hpp"
+
+
+class StripedMemoryDatabase : public DatabaseInterface {
+public:
+    explicit StripedMemoryDatabase(std::size_t stripes = 64) : shards_(std::make_unique<Shard[]>(stripes)), stripes_(stripes) {}
+
+    void saveData(const std::string& data) override {
+        store(data);
+    }
+
+    void saveBatch(std::span<const std::string_view> records) override {
+        for (std::string_view r : records) store(r);
+    }
+
+    std::optional<std::string> loadData(std::string_view key) override {
+        const Shard& shard = shardOf(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.records.find(key);
+        if (it == shard.records.end()) return std::nullopt;
+        return it->second;
+    }
+
+    std::size_t size() const {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < stripes_; ++i) {
+            std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+            total += shards_[i].records.size();
+        }
+        return total;
+    }
+
+private:
+    // Lets the maps be searched with a std::string_view without building a std::string.
+    struct KeyHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+    };
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, std::string, KeyHash, std::equal_to<>> records;
+    };
+
+    Shard& shardOf(std::string_view key) const {
+        return shards_[KeyHash{}(key) % stripes_];
+    }
+
+    void store(std::string_view record) {
+        const std::string_view key = recordKey(record);
+        Shard& shard = shardOf(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.records.find(key);
+        if (it != shard.records.end()) it->second.assign(record);
+        else shard.records.emplace(std::string(key), std::string(record));
+    }
+
+    std::unique_ptr<Shard[]> shards_;
+    std::size_t stripes_;
+};
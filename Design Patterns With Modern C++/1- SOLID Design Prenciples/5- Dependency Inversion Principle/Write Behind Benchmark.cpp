@@ -0,0 +1,120 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief How long does "saveData()" keep the caller waiting? Synchronous saves into a "LogStructuredDatabase" that fsyncs every write,
+ *        vs. the same backend behind a "WriteBehindDatabase" (p50/p99 of the enqueue latency, plus the time "durabilityBarrier()" takes
+ *        to get everything on disk). Then the three overflow policies with a tiny queue in front of a slow backend.
+ *
+ *        Build: g++ -std=c++20 -O2 -pthread "Write Behind Benchmark.cpp" -o WriteBehindBenchmark
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
+
+#include "LogStructuredDatabase.hpp"
+#include "StripedMemoryDatabase.hpp"
+#include "WriteBehindDatabase.hpp"
+
+
+using Clock = std::chrono::steady_clock;
+
+static void printLatencies(const char* name, std::vector<Clock::duration>& latencies) {
+    std::sort(latencies.begin(), latencies.end());
+    auto us = [](Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); };
+    std::cout << name << ": p50 = " << us(latencies[latencies.size() / 2]) << " us, p99 = "
+              << us(latencies[latencies.size() * 99 / 100]) << " us" << std::endl;
+}
+
+static std::vector<Clock::duration> timeSaves(DatabaseInterface& database, int records) {
+    std::vector<Clock::duration> latencies;
+    const std::string value(100, 'x');
+    for (int i = 0; i < records; ++i) {
+        const std::string record = "key" + std::to_string(i) + "=" + value;
+        auto start = Clock::now();
+        database.saveData(record);
+        latencies.push_back(Clock::now() - start);
+    }
+    return latencies;
+}
+
+// Decorator that makes any backend slow, so that the queue in front of it overflows.
+class SlowDatabase : public DatabaseInterface {
+public:
+    explicit SlowDatabase(DatabaseInterface& backend) : backend_(backend) {}
+
+    void saveData(const std::string& data) override {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        backend_.saveData(data);
+    }
+
+private:
+    DatabaseInterface& backend_;
+};
+
+int main() {
+    namespace fs = std::filesystem;
+    const int records = 3000;
+
+    {
+        fs::remove_all("wb_sync");
+        LogStructuredDatabase database(LogStructuredOptions{"wb_sync", FsyncPolicy::Always});
+        auto latencies = timeSaves(database, records);
+        printLatencies("Synchronous saveData   ", latencies);
+    }
+
+    {
+        fs::remove_all("wb_async");
+        LogStructuredDatabase database(LogStructuredOptions{"wb_async", FsyncPolicy::Never});
+        WriteBehindOptions options;
+        options.onBarrier = [&database] { database.sync(); };
+        WriteBehindDatabase writeBehind(database, options);
+
+        auto latencies = timeSaves(writeBehind, records);
+        printLatencies("Write-behind enqueue   ", latencies);
+
+        auto start = Clock::now();
+        writeBehind.durabilityBarrier();
+        std::cout << "Durability barrier     : " << std::chrono::duration<double, std::milli>(Clock::now() - start).count()
+                  << " ms for the whole backlog" << std::endl;
+    }
+
+    for (OverflowPolicy policy : {OverflowPolicy::Block, OverflowPolicy::Drop, OverflowPolicy::SpillToDisk}) {
+        StripedMemoryDatabase memory;
+        SlowDatabase slow(memory);
+        WriteBehindOptions options;
+        options.capacity = 16;
+        options.overflow = policy;
+
+        auto start = Clock::now();
+        std::size_t dropped = 0, spilled = 0;
+        {
+            WriteBehindDatabase writeBehind(slow, options);
+            for (int i = 0; i < 500; ++i) writeBehind.saveData("key" + std::to_string(i) + "=value");
+            writeBehind.flush();
+            dropped = writeBehind.dropped();
+            spilled = writeBehind.spilled();
+        }
+        const char* name = policy == OverflowPolicy::Block ? "Block      " : policy == OverflowPolicy::Drop ? "Drop       " : "SpillToDisk";
+        std::cout << name << ": saved " << memory.size() << "/500, dropped " << dropped << ", spilled " << spilled
+                  << ", producer + flush took " << std::chrono::duration<double, std::milli>(Clock::now() - start).count()
+                  << " ms" << std::endl;
+    }
+
+    fs::remove_all("wb_sync");
+    fs::remove_all("wb_async");
+
+    getchar();
+    return 0;
+}
@@ -0,0 +1,404 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief WriteBehindDatabase: a decorator that takes storage latency out of "BusinessLogic::processData()".
+ *
+ *        It is itself a "DatabaseInterface", so "BusinessLogic" does not know it is there (DIP at work). "saveData()" only moves the
+ *        record into a bounded lock-free queue and returns, and a background thread drains the queue into the wrapped backend
+ *        with "saveBatch()", so the backend also gets group commit for free.
+ *
+ *        - flush()             : returns once every record saved before the call was handed to the backend.
+ *        - durabilityBarrier() : flush(), then the "onBarrier" hook (e.g. "LogStructuredDatabase::sync()"), for records that must
+ *                                be on stable storage before we answer the client.
+ *        - When the queue is full the OverflowPolicy decides: wait for room, drop the record (counted), or spill it to a local file
+ *          that the background thread replays once it caught up. While spilling, new records go to the spill file too, so the
+ *          records of one thread still reach the backend in order. If the spill file cannot be opened or written, saveData()
+ *          throws and the record is not taken; records the drain thread cannot read back are counted as dropped.
+ *
+ *        Reads are queued for the background thread too, which answers them from the backend once the records saved before them
+ *        were handed over, so they see every record saved before them.
+ *
+ *        If the backend throws (a "LogStructuredDatabase" whose WAL failed), the background thread keeps the exception and stops:
+ *        the failed batch is not counted as committed, and every later saveData(), saveBatch(), loadData() and flush() (including
+ *        the ones already waiting) rethrows it. What was still queued is lost.
+ *
+ *        Thread safety: thread-safe (any number of producers and readers). The wrapped backend is only ever called from the
+ *        background thread, so it may be single-threaded. "onBarrier" runs on the thread that calls durabilityBarrier().
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <future>
+#include <optional>
+#include <exception>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <filesystem>
+
+#include "DatabaseInterface.hpp"
+
+
+enum class OverflowPolicy {
+    Block,        // Wait until the background thread made room
+    Drop,         // Throw the record away and count it
+    SpillToDisk   // Append it to the spill file, it is saved later
+};
+
+struct WriteBehindOptions {
+    std::size_t capacity = 4096;                         // Queue slots
+    std::size_t maxBatch = 256;                          // Records per saveBatch() on the backend
+    OverflowPolicy overflow = OverflowPolicy::Block;
+    std::filesystem::path spillPath = "write_behind.spill";
+    std::function<void()> onBarrier;                     // Makes the backend durable, called by durabilityBarrier() on its thread
+};
+
+class WriteBehindDatabase : public DatabaseInterface {
+public:
+    WriteBehindDatabase(DatabaseInterface& backend, WriteBehindOptions options = {})
+        : backend_(backend), options_(std::move(options)), cells_(std::make_unique<Cell[]>(options_.capacity)) {
+        for (std::size_t i = 0; i < options_.capacity; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+        drainer_ = std::thread([this] { drainLoop(); });
+    }
+
+    // Everything accepted so far still reaches the backend, unless it failed.
+    ~WriteBehindDatabase() override {
+        stop_.store(true, std::memory_order_release);
+        wakeDrainer();
+        drainer_.join();
+        if (spill_) {
+            std::fclose(spill_);
+            std::filesystem::remove(options_.spillPath);
+        }
+    }
+
+    WriteBehindDatabase(const WriteBehindDatabase&) = delete;
+    WriteBehindDatabase& operator=(const WriteBehindDatabase&) = delete;
+
+    void saveData(const std::string& data) override {
+        checkFailed();
+        enqueue(std::string(data));
+    }
+
+    void saveBatch(std::span<const std::string_view> records) override {
+        checkFailed();
+        for (std::string_view r : records) enqueue(std::string(r));
+    }
+
+    // Read-your-writes: the drain thread answers once every record saved before the call reached the backend.
+    std::optional<std::string> loadData(std::string_view key) override {
+        checkFailed();
+        Read read{key, enqueuePos_.load(std::memory_order_acquire), spillAccepted(), {}};
+        auto answer = read.answer.get_future();
+        {
+            std::lock_guard<std::mutex> lock(readsMutex_);
+            reads_.push_back(&read);
+        }
+        wakeDrainer();
+        return answer.get();
+    }
+
+    void flush() {
+        const std::uint64_t target = enqueuePos_.load(std::memory_order_acquire);
+        const std::uint64_t spillTarget = spillAccepted();
+        wakeDrainer();
+        waitUntil(committedPos_, target);
+        waitUntil(spillCommitted_, spillTarget);
+    }
+
+    void durabilityBarrier() {
+        flush();
+        if (options_.onBarrier) options_.onBarrier();
+    }
+
+    std::size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    std::size_t spilled() const { return spilledTotal_.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<std::uint64_t> seq;
+        std::string record;
+    };
+
+    // A loadData() waiting for the drain thread: answered once the queue and the spill file were committed up to the targets.
+    struct Read {
+        std::string_view key;
+        std::uint64_t target;
+        std::uint64_t spillTarget;
+        std::promise<std::optional<std::string>> answer;
+    };
+
+    // The backend's exception, once the drain thread stopped on it.
+    void checkFailed() const {
+        if (failed_.load(std::memory_order_acquire)) std::rethrow_exception(failure_);
+    }
+
+    std::uint64_t spillAccepted() {
+        std::lock_guard<std::mutex> lock(spillMutex_);
+        return spillAccepted_;
+    }
+
+    // Bounded multi-producer queue with a sequence number per cell, the single consumer is the drain thread.
+    bool tryPush(std::string& record) {
+        std::uint64_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos % options_.capacity];
+            const auto diff = static_cast<std::int64_t>(cell.seq.load(std::memory_order_acquire) - pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.record = std::move(record);
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Full
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(std::string& record) {
+        Cell& cell = cells_[dequeuePos_ % options_.capacity];
+        if (cell.seq.load(std::memory_order_acquire) != dequeuePos_ + 1) return false;
+        record = std::move(cell.record);
+        cell.seq.store(dequeuePos_ + options_.capacity, std::memory_order_release);
+        ++dequeuePos_;
+        return true;
+    }
+
+    void enqueue(std::string record) {
+        if (spilling_.load(std::memory_order_acquire) && spill(record)) return;
+
+        for (;;) {
+            const std::uint32_t freed = freed_.load(std::memory_order_acquire);
+            checkFailed();   // Nobody will ever make room
+            if (tryPush(record)) {
+                wakeDrainer();
+                return;
+            }
+            switch (options_.overflow) {
+            case OverflowPolicy::Drop:
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            case OverflowPolicy::SpillToDisk:
+                spilling_.store(true, std::memory_order_release);
+                if (spill(record)) return;
+                break; // The drain thread just finished replaying the spill file, try the queue again
+            case OverflowPolicy::Block:
+                freed_.wait(freed, std::memory_order_acquire);
+                break;
+            }
+        }
+    }
+
+    // Spill file records: [size:u32][record bytes]. Returns false if spilling ended in the meantime.
+    bool spill(const std::string& record) {
+        std::lock_guard<std::mutex> lock(spillMutex_);
+        if (!spilling_.load(std::memory_order_relaxed)) return false;
+        if (!spill_) {
+            spill_ = std::fopen(options_.spillPath.string().c_str(), "w+b");
+            if (!spill_) throw std::runtime_error("WriteBehindDatabase: cannot open the spill file " + options_.spillPath.string());
+            spillBytes_ = 0;
+        }
+        const auto size = static_cast<std::uint32_t>(record.size());
+        if (std::fwrite(&size, sizeof(size), 1, spill_) != 1 ||
+            std::fwrite(record.data(), 1, record.size(), spill_) != record.size()) {
+            std::fseek(spill_, static_cast<long>(spillBytes_), SEEK_SET);   // The next record overwrites the torn one
+            throw std::runtime_error("WriteBehindDatabase: cannot write the spill file " + options_.spillPath.string());
+        }
+        spillBytes_ += sizeof(size) + record.size();
+        ++spillAccepted_;
+        spilledTotal_.fetch_add(1, std::memory_order_relaxed);
+        wakeDrainer();
+        return true;
+    }
+
+    // Reads the spill file back and ends spilling, under the spill lock so no record can sneak in between.
+    std::vector<std::string> takeSpilled(std::uint64_t& count) {
+        std::vector<std::string> records;
+        std::lock_guard<std::mutex> lock(spillMutex_);
+        if (spill_) {
+            std::fflush(spill_);
+            std::rewind(spill_);
+            std::uint64_t left = spillBytes_;   // Past it: a torn record that spill() gave up on
+            std::uint32_t size = 0;
+            while (left >= sizeof(size) && std::fread(&size, sizeof(size), 1, spill_) == 1 && left - sizeof(size) >= size) {
+                std::string record(size, '\0');
+                if (std::fread(record.data(), 1, size, spill_) != size) break;
+                records.push_back(std::move(record));
+                left -= sizeof(size) + size;
+            }
+            std::fclose(spill_);
+            spill_ = nullptr;   // The next spill() starts a new, empty file
+            std::error_code ignored;
+            std::filesystem::remove(options_.spillPath, ignored);
+            // A failed delayed write (e.g. a full disk) only shows up here: what cannot be read back is lost.
+            const std::uint64_t inFile = spillAccepted_ - spillCommitted_.load(std::memory_order_relaxed);
+            dropped_.fetch_add(inFile - records.size(), std::memory_order_relaxed);
+        }
+        count = spillAccepted_;
+        spilling_.store(false, std::memory_order_release);
+        return records;
+    }
+
+    // False if the backend threw: the drain thread has failed.
+    bool commit(std::vector<std::string>& records, std::size_t count) {
+        views_.clear();
+        for (std::size_t i = 0; i < count; ++i) views_.push_back(records[i]);
+        try {
+            for (std::size_t offset = 0; offset < views_.size(); offset += options_.maxBatch) {
+                const std::size_t n = std::min(options_.maxBatch, views_.size() - offset);
+                backend_.saveBatch(std::span<const std::string_view>(views_.data() + offset, n));
+            }
+        } catch (...) {
+            fail(std::current_exception());
+            return false;
+        }
+        return true;
+    }
+
+    // Drain thread: "failure_" is written once, before "failed_" publishes it. Wakes the producers blocked on a full queue
+    // and the flush() calls.
+    void fail(std::exception_ptr failure) {
+        failure_ = std::move(failure);
+        failed_.store(true, std::memory_order_release);
+        freed_.fetch_add(1, std::memory_order_release);
+        freed_.notify_all();
+        progressed();
+    }
+
+    void progressed() {
+        progress_.fetch_add(1, std::memory_order_release);
+        progress_.notify_all();
+    }
+
+    // Drain thread: asks the backend for the reads whose records were all committed. The reader owns "Read" and returns as soon
+    // as its answer is set, so it is not touched after that.
+    void answerReads() {
+        std::vector<Read*> ready;
+        {
+            std::lock_guard<std::mutex> lock(readsMutex_);
+            if (reads_.empty()) return;
+            const std::uint64_t spillCommitted = spillCommitted_.load(std::memory_order_relaxed);
+            auto waiting = std::partition(reads_.begin(), reads_.end(), [&](const Read* read) {
+                return read->target > dequeuePos_ || read->spillTarget > spillCommitted;
+            });
+            ready.assign(waiting, reads_.end());
+            reads_.erase(waiting, reads_.end());
+        }
+        for (Read* read : ready) {
+            try {
+                read->answer.set_value(backend_.loadData(read->key));
+            } catch (...) {
+                read->answer.set_exception(std::current_exception());
+            }
+        }
+    }
+
+    // Drain thread, once it failed: the waiting reads will never see their records committed.
+    void failReads() {
+        std::vector<Read*> waiting;
+        {
+            std::lock_guard<std::mutex> lock(readsMutex_);
+            waiting.swap(reads_);
+        }
+        for (Read* read : waiting) read->answer.set_exception(failure_);
+    }
+
+    void drainLoop() {
+        std::vector<std::string> batch(options_.maxBatch);
+        for (;;) {
+            const std::uint32_t signal = signal_.load(std::memory_order_acquire);
+            if (failed_.load(std::memory_order_relaxed)) {   // Only answers the reads (with the failure) from now on
+                failReads();
+                if (stop_.load(std::memory_order_acquire)) return;
+                signal_.wait(signal, std::memory_order_acquire);
+                continue;
+            }
+            answerReads();
+
+            std::size_t n = 0;
+            while (n < options_.maxBatch && tryPop(batch[n])) ++n;
+            if (n > 0) {
+                freed_.fetch_add(1, std::memory_order_release);
+                freed_.notify_all();
+                if (!commit(batch, n)) continue;
+                committedPos_.store(dequeuePos_, std::memory_order_release);
+                progressed();
+                continue;
+            }
+
+            // The queue is empty, so everything left in the spill file is the oldest data we have.
+            if (spilling_.load(std::memory_order_acquire)) {
+                std::uint64_t count = 0;
+                auto spilled = takeSpilled(count);
+                if (!commit(spilled, spilled.size())) continue;
+                spillCommitted_.store(count, std::memory_order_release);
+                progressed();
+                continue;
+            }
+
+            if (stop_.load(std::memory_order_acquire)) return;
+            signal_.wait(signal, std::memory_order_acquire);
+        }
+    }
+
+    void wakeDrainer() {
+        signal_.fetch_add(1, std::memory_order_release);
+        signal_.notify_one();
+    }
+
+    // Waits for "counter" (committedPos_ or spillCommitted_) to reach "target", throws if the drain thread fails first.
+    void waitUntil(const std::atomic<std::uint64_t>& counter, std::uint64_t target) {
+        for (;;) {
+            const std::uint32_t progress = progress_.load(std::memory_order_acquire);
+            if (counter.load(std::memory_order_acquire) >= target) return;
+            checkFailed();
+            progress_.wait(progress, std::memory_order_acquire);
+        }
+    }
+
+    DatabaseInterface& backend_;
+    WriteBehindOptions options_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<std::uint64_t> enqueuePos_{0};
+    alignas(64) std::uint64_t dequeuePos_ = 0;              // Drain thread only
+    alignas(64) std::atomic<std::uint64_t> committedPos_{0};
+    std::atomic<std::uint32_t> signal_{0};                  // Bumped when there is something for the drain thread
+    std::atomic<std::uint32_t> freed_{0};                   // Bumped when the drain thread made room
+    std::atomic<std::uint32_t> progress_{0};                // Bumped when a commit counter moved or the drain thread failed
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> failed_{false};
+    std::exception_ptr failure_;                             // The backend's exception, valid once failed_ is set
+    std::atomic<std::size_t> dropped_{0};
+    std::vector<std::string_view> views_;                   // Drain thread only
+
+    std::mutex readsMutex_;
+    std::vector<Read*> reads_;                               // Waiting loadData() calls
+
+    std::mutex spillMutex_;
+    std::FILE* spill_ = nullptr;
+    std::uint64_t spillBytes_ = 0;                          // Complete records in the spill file
+    std::uint64_t spillAccepted_ = 0;
+    std::atomic<std::uint64_t> spillCommitted_{0};
+    std::atomic<bool> spilling_{false};
+    std::atomic<std::size_t> spilledTotal_{0};
+
+    std::thread drainer_;
+};
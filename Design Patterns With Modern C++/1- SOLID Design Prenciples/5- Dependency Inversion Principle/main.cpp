@@ -17,6 +17,10 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <thread>
+#include <chrono>
+
+#include "DatabaseInterface.hpp"  // Build with: g++ -std=c++20 -pthread main.cpp
 
 /**
  * \brief The following example will demonstrate a violation for ISP concept, so make sure to read the example well before reading
@@ -76,39 +80,15 @@ int main() {
 //Example:
 //=========
 
-// Abstract interface for database operations
-class DatabaseInterface {
-public:
-    virtual void saveData(const std::string& data) = 0;
-    virtual ~DatabaseInterface() = default;
-};
-
-// Low-level module: Concrete Database implementation
-class Database : public DatabaseInterface {
-public:
-    void saveData(const std::string& data) override {
-        std::cout << "Saving data to database: " << data << std::endl;
-    }
-};
-
-// High-level module: BusinessLogic (Depends on DatabaseInterface via Dependency Injection)
-class BusinessLogic {
-private:
-    DatabaseInterface* database; //Using a shared pointer will be much better, but I used a raw pointer for simpleness.
-                                 // std::shared_ptr<DatabaseInterface> database;
-
-public:
-    // Constructor injection of DatabaseInterface
-    BusinessLogic(DatabaseInterface* db) : database(db) {}
-
-    void processData(const std::string& data) {
-        // Perform business logic
-        std::cout << "Processing data: " << data << std::endl;
-
-        // Save processed data using DatabaseInterface (abstraction)
-        database->saveData(data);
-    }
-};
+// The abstraction "DatabaseInterface", the concrete "Database" and the high-level "BusinessLogic" live in "DatabaseInterface.hpp"
+// so the other examples of this folder can reuse them:
+//
+//   - DatabaseInterface : saveData() for one record, saveBatch() for a group of records (falls back to saveData() by default),
+//                         loadData() to read the latest record of a key back.
+//   - Database          : Low-level module, the concrete implementation.
+//   - BusinessLogic     : High-level module, it only knows DatabaseInterface (Dependency Injection) and can group records
+//                         before committing them (GroupCommitPolicy). "BusinessLogic<SomeDb>" injects the backend at compile
+//                         time instead (any type satisfying the "DatabaseBackend" concept), see "Static Dispatch Benchmark.cpp".
 
 int main() {
     // Create Database instance (Concrete implementation)
@@ -120,6 +100,14 @@ int main() {
     // Use BusinessLogic to process and save data
     businessLogic.processData("Hello, World!");
 
+    // Group commit: records are handed to the database 3 at a time through saveBatch()
+    BusinessLogic groupedLogic(&concreteDatabase, GroupCommitPolicy{3, std::chrono::milliseconds(5)});
+    for (const char* record : {"first", "second", "third", "fourth"}) {
+        groupedLogic.processData(record);
+    }
+    // "fourth" is still pending, its 5 ms deadline commits it (groupedLogic.flush() would commit it right away)
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
     getchar();
     return 0;
 }
@@ -0,0 +1,135 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Time and heap allocations per Car, for 10M cars:
+ *
+ *        1) The original builder: "const std::string&" setters that copy, and a "build()" that copies the Car again.
+ *        2) The move-aware "CarBuilder": sink setters and "build() &&", the strings are created once and moved into place.
+ *        3) CSV rows fed one by one through "CarBuilder" into a vector that grows as it goes.
+ *        4) "buildCars()": the same CSV in one call, the vector reserved once.
+ *
+ *        Short strings ("BMW", "Blue") fit in std::string's small buffer (no allocation either way), the longer makes, models
+ *        and colors ("Land Cruiser Prado") need a heap block, which is where the copies hurt.
+ *
+ *        Build: g++ -std=c++20 -O2 "Builder Benchmark.cpp" -o BuilderBenchmark   (needs about 2 GB of memory)
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "CarBuilder.hpp"
+#include "../../Utilities/AllocationCounter.hpp"
+
+
+// The builder as it was before: every setter copies its argument, build() copies the whole Car.
+class CopyingCarBuilder {
+public:
+    CopyingCarBuilder& setMake(const std::string& make) { car_.setMake(make); return *this; }
+    CopyingCarBuilder& setModel(const std::string& model) { car_.setModel(model); return *this; }
+    CopyingCarBuilder& setYear(int year) { car_.setYear(year); return *this; }
+    CopyingCarBuilder& setColor(const std::string& color) { car_.setColor(color); return *this; }
+
+    Car build() { return car_; }
+
+private:
+    Car car_;
+};
+
+static const char* const makes[] = {"Toyota", "BMW", "Mercedes-Benz AMG", "Volkswagen Commercial"};
+static const char* const models[] = {"Camry", "X6", "Land Cruiser Prado", "Golf GTI Clubsport S"};
+static const char* const colors[] = {"Blue", "Black", "Midnight Silver Metallic", "White"};
+
+struct Measure {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::size_t allocations0 = AllocationCounter::allocations();
+    std::size_t bytes0 = AllocationCounter::bytes();
+
+    void report(const char* name, std::size_t cars) const {
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << ": " << ns / cars << " ns/car, " << double(AllocationCounter::allocations() - allocations0) / cars << " allocations/car, "
+                  << double(AllocationCounter::bytes() - bytes0) / cars << " bytes/car" << std::endl;
+    }
+};
+
+int main() {
+    const std::size_t count = 10000000;
+    std::size_t checksum = 0;
+
+    {
+        std::vector<Car> cars;
+        cars.reserve(count);
+
+        Measure m;
+        for (std::size_t i = 0; i < count; ++i) {
+            cars.push_back(CopyingCarBuilder()
+                               .setMake(makes[i % 4])
+                               .setModel(models[(i / 4) % 4])
+                               .setYear(2000 + int(i % 25))
+                               .setColor(colors[(i / 16) % 4])
+                               .build());
+        }
+        m.report("1) Copying setters + copying build()   ", count);
+        checksum += cars.back().model().size();
+
+        cars.clear();
+        Measure n;
+        for (std::size_t i = 0; i < count; ++i) {
+            cars.push_back(CarBuilder()
+                               .setMake(makes[i % 4])
+                               .setModel(models[(i / 4) % 4])
+                               .setYear(2000 + int(i % 25))
+                               .setColor(colors[(i / 16) % 4])
+                               .build());
+        }
+        n.report("2) Sink setters + build() &&           ", count);
+        checksum += cars.back().model().size();
+    }
+
+    std::string csv;
+    for (std::size_t i = 0; i < count; ++i) {
+        csv.append(makes[i % 4]).append(",").append(models[(i / 4) % 4]).append(",").append(std::to_string(2000 + i % 25))
+           .append(",").append(colors[(i / 16) % 4]).append("\n");
+    }
+
+    {
+        Measure m;
+        std::vector<Car> cars;
+        std::string_view rest = csv;
+        while (!rest.empty()) {
+            const std::size_t end = rest.find('\n');
+            std::string_view line = rest.substr(0, end);
+            rest.remove_prefix(end + 1);
+            const std::size_t a = line.find(','), b = line.find(',', a + 1), c = line.find(',', b + 1);
+            cars.push_back(CarBuilder()
+                               .setMake(std::string(line.substr(0, a)))
+                               .setModel(std::string(line.substr(a + 1, b - a - 1)))
+                               .setYear(std::atoi(std::string(line.substr(b + 1, c - b - 1)).c_str()))
+                               .setColor(std::string(line.substr(c + 1)))
+                               .build());
+        }
+        m.report("3) CSV row by row, growing vector      ", count);
+        checksum += cars.size();
+    }
+
+    {
+        Measure m;
+        std::vector<Car> cars = buildCars(csv);
+        m.report("4) buildCars(csv), one reservation     ", count);
+        checksum += cars.size();
+    }
+
+    std::cout << "checksum " << checksum << std::endl;
+
+    getchar();
+    return 0;
+}
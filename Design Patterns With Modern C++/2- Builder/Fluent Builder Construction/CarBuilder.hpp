@@ -0,0 +1,163 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief The "Car" product and its Fluent Builder "CarBuilder" from "main.cpp", moved into a header so the other examples and
+ *        benchmarks of this folder can build the same cars.
+ *
+ *        Move-aware version:
+ *          - The setters take their string "by value" (sink parameters) and move it into place: a string literal or a temporary
+ *            is turned into a std::string once, and never copied again on its way into the Car.
+ *          - Each setter has an "&" and an "&&" overload, so a chain that starts on a temporary "CarBuilder()" stays an rvalue
+ *            and ends in "build() &&", which moves the Car out instead of copying its three strings.
+ *            "build() const &" (on a named builder) still copies, so the builder can be reused as a template.
+ *          - buildCars() builds a whole "std::vector<Car>" from CSV rows with a single reservation.
+ *
+ *        Build (any file including this header): g++ -std=c++20 <file>.cpp
+ */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <charconv>
+#include <algorithm>
+#include <stdexcept>
+
+
+// Product: Car class representing the complex object to be built
+class Car {
+public:
+
+    // Elements Setters (sink parameters: the caller's temporary is moved in, not copied):
+    void setMake(std::string make) { make_ = std::move(make); }
+    void setModel(std::string model) { model_ = std::move(model); }
+    void setYear(int year) { year_ = year; }
+    void setColor(std::string color) { color_ = std::move(color); }
+
+    // Elements Getters:
+    const std::string& make() const { return make_; }
+    const std::string& model() const { return model_; }
+    int year() const { return year_; }
+    const std::string& color() const { return color_; }
+
+    void describe() const {
+        std::cout << "Car Details:" << std::endl;
+        std::cout << "Make: " << make_ << std::endl;
+        std::cout << "Model: " << model_ << std::endl;
+        std::cout << "Year: " << year_ << std::endl;
+        std::cout << "Color: " << color_ << std::endl;
+    }
+
+private:
+    // These are the elements that will be configuered (built) by the builder class.
+    std::string make_;
+    std::string model_;
+    int year_ = 0;
+    std::string color_;
+};
+
+// Fluent Builder: Provides a fluent interface for configuring a Car object
+class CarBuilder {
+public:
+    CarBuilder& setMake(std::string make) & {
+        car_.setMake(std::move(make));
+        return *this; // Return a reference to the current builder
+    }
+
+    CarBuilder&& setMake(std::string make) && {
+        car_.setMake(std::move(make));
+        return std::move(*this); // Still a temporary: the rest of the chain (and build()) may move from it
+    }
+
+    CarBuilder& setModel(std::string model) & {
+        car_.setModel(std::move(model));
+        return *this;
+    }
+
+    CarBuilder&& setModel(std::string model) && {
+        car_.setModel(std::move(model));
+        return std::move(*this);
+    }
+
+    CarBuilder& setYear(int year) & {
+        car_.setYear(year);
+        return *this;
+    }
+
+    CarBuilder&& setYear(int year) && {
+        car_.setYear(year);
+        return std::move(*this);
+    }
+
+    CarBuilder& setColor(std::string color) & {
+        car_.setColor(std::move(color));
+        return *this;
+    }
+
+    CarBuilder&& setColor(std::string color) && {
+        car_.setColor(std::move(color));
+        return std::move(*this);
+    }
+
+    // Named builder: copy, so the builder can build more cars.
+    Car build() const & {
+        return car_;
+    }
+
+    // Temporary builder (end of a chain, or std::move(builder)): nobody will use it again, so move the Car out.
+    Car build() && {
+        return std::move(car_);
+    }
+
+private:
+    Car car_; // The Car object being constructed
+};
+
+// Bulk builder: one Car per CSV row "make,model,year,color" (empty lines are skipped, '\r' before '\n' is ignored).
+// The vector is reserved once for the number of lines, and every field goes straight from the text into its Car.
+inline std::vector<Car> buildCars(std::string_view csv) {
+    std::vector<Car> cars;
+    cars.reserve(static_cast<std::size_t>(std::count(csv.begin(), csv.end(), '\n')) + 1);
+
+    std::size_t lineNumber = 0;
+    while (!csv.empty()) {
+        const std::size_t end = csv.find('\n');
+        std::string_view line = csv.substr(0, end);
+        csv.remove_prefix(end == std::string_view::npos ? csv.size() : end + 1);
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty()) continue;
+
+        std::string_view fields[4];
+        std::size_t count = 0;
+        bool extraFields = false;
+        for (;;) {
+            if (count == 4) { extraFields = true; break; }
+            const std::size_t comma = line.find(',');
+            fields[count++] = line.substr(0, comma);
+            if (comma == std::string_view::npos) break;
+            line.remove_prefix(comma + 1);
+        }
+
+        int year = 0;
+        const auto [parsed, error] = std::from_chars(fields[2].data(), fields[2].data() + fields[2].size(), year);
+        if (count != 4 || extraFields || error != std::errc() || parsed != fields[2].data() + fields[2].size()) {
+            throw std::invalid_argument("buildCars: malformed row " + std::to_string(lineNumber));
+        }
+
+        Car& car = cars.emplace_back();
+        car.setMake(std::string(fields[0]));
+        car.setModel(std::string(fields[1]));
+        car.setYear(year);
+        car.setColor(std::string(fields[3]));
+    }
+    return cars;
+}
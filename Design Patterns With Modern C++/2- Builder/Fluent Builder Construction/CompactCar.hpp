@@ -0,0 +1,117 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief CompactCar: the same product as "Car", for inventories of tens of millions of cars.
+ *
+ *        Make, model and color come from a tiny set of values, so instead of three std::string (3 x 32 bytes, plus a heap block each
+ *        for names past 15 characters) a CompactCar keeps three 32-bit ids from the global "SymbolTable": 16 bytes per car in total.
+ *        Two cars have the same make exactly when they have the same id, so comparing them never touches a character.
+ *        The names are only looked up when they are needed, e.g. by describe().
+ *
+ *        "CompactCarBuilder" is the Fluent Builder for it, with the same setters as "CarBuilder".
+ */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <functional>
+
+#include "CarBuilder.hpp"
+#include "../../Utilities/SymbolTable.hpp"
+
+
+class CompactCar {
+public:
+    using Symbol = SymbolTable::Id;
+
+    // Elements Setters:
+    void setMake(std::string_view make) { make_ = SymbolTable::global().intern(make); }
+    void setModel(std::string_view model) { model_ = SymbolTable::global().intern(model); }
+    void setYear(int year) { year_ = year; }
+    void setColor(std::string_view color) { color_ = SymbolTable::global().intern(color); }
+
+    // Elements Getters: the names are resolved on demand, the symbols are free.
+    std::string_view make() const { return SymbolTable::global().name(make_); }
+    std::string_view model() const { return SymbolTable::global().name(model_); }
+    int year() const { return year_; }
+    std::string_view color() const { return SymbolTable::global().name(color_); }
+
+    Symbol makeSymbol() const { return make_; }
+    Symbol modelSymbol() const { return model_; }
+    Symbol colorSymbol() const { return color_; }
+
+    // Four integer comparisons.
+    bool operator==(const CompactCar&) const = default;
+
+    void describe() const {
+        std::cout << "Car Details:" << std::endl;
+        std::cout << "Make: " << make() << std::endl;
+        std::cout << "Model: " << model() << std::endl;
+        std::cout << "Year: " << year_ << std::endl;
+        std::cout << "Color: " << color() << std::endl;
+    }
+
+    Car toCar() const {
+        return CarBuilder()
+                .setMake(std::string(make()))
+                .setModel(std::string(model()))
+                .setYear(year_)
+                .setColor(std::string(color()))
+                .build();
+    }
+
+private:
+    Symbol make_ = 0;   // Id 0 is the empty string
+    Symbol model_ = 0;
+    std::int32_t year_ = 0;
+    Symbol color_ = 0;
+};
+
+static_assert(sizeof(CompactCar) == 16);
+
+template <>
+struct std::hash<CompactCar> {
+    std::size_t operator()(const CompactCar& car) const {
+        const std::uint64_t names = (std::uint64_t(car.makeSymbol()) << 32) ^ (std::uint64_t(car.modelSymbol()) << 16) ^ car.colorSymbol();
+        return std::hash<std::uint64_t>{}(names * 31 + static_cast<std::uint32_t>(car.year()));
+    }
+};
+
+// Fluent Builder for CompactCar, same chain as CarBuilder. The builder is 16 bytes, copying or moving it is free.
+class CompactCarBuilder {
+public:
+    CompactCarBuilder& setMake(std::string_view make) {
+        car_.setMake(make);
+        return *this;
+    }
+
+    CompactCarBuilder& setModel(std::string_view model) {
+        car_.setModel(model);
+        return *this;
+    }
+
+    CompactCarBuilder& setYear(int year) {
+        car_.setYear(year);
+        return *this;
+    }
+
+    CompactCarBuilder& setColor(std::string_view color) {
+        car_.setColor(color);
+        return *this;
+    }
+
+    CompactCar build() const {
+        return car_;
+    }
+
+private:
+    CompactCar car_;
+};
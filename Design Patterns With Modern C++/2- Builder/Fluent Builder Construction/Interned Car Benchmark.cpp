@@ -0,0 +1,135 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief "Car" (three std::string) vs. "CompactCar" (three interned 32-bit symbols) for an inventory of 10M cars (or argv[1]):
+ *
+ *        1) Resident memory of the inventory (Linux: from /proc/self/statm, elsewhere only sizeof is printed).
+ *        2) Comparisons: counting the cars equal to a given car, and the cars of a given make.
+ *        3) Interning from several threads at once gives every thread the same ids.
+ *
+ *        Build: g++ -std=c++20 -O2 -pthread "Interned Car Benchmark.cpp" -o InternedCarBenchmark
+ */
+
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#include "CarBuilder.hpp"
+#include "CompactCar.hpp"
+
+
+// Resident set size in bytes, 0 when the platform does not tell.
+static std::size_t residentBytes() {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    std::size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * 4096;
+#else
+    return 0;
+#endif
+}
+
+static const char* const makes[] = {"Toyota", "BMW", "Mercedes-Benz", "Volkswagen", "Hyundai", "Ford", "Land Rover", "Chevrolet"};
+static const char* const models[] = {"Camry", "X6", "C-Class Coupe AMG", "Golf GTI Clubsport", "Tucson", "F-150 Raptor",
+                                     "Range Rover Evoque", "Silverado 1500 LTZ", "Corolla", "3 Series", "E-Class Estate",
+                                     "Passat Variant", "Elantra", "Mustang Mach-E", "Defender 110", "Tahoe"};
+static const char* const colors[] = {"Blue", "Black", "White", "Midnight Silver Metallic", "Red", "Pearl White Multi-Coat",
+                                     "Grey", "Deep Blue Metallic"};
+
+template <typename Builder>
+static auto buildInventory(std::size_t count) {
+    std::vector<decltype(Builder().build())> cars;
+    cars.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        cars.push_back(Builder()
+                           .setMake(makes[i % 8])
+                           .setModel(models[(i / 8) % 16])
+                           .setYear(1995 + int(i % 30))
+                           .setColor(colors[(i / 128) % 8])
+                           .build());
+    }
+    return cars;
+}
+
+template <typename Body>
+static double milliseconds(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool concurrentInterning() {
+    const unsigned threads = 4;
+    std::vector<std::vector<SymbolTable::Id>> ids(threads);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([t, &ids] {
+            for (int i = 0; i < 20000; ++i) ids[t].push_back(SymbolTable::global().intern("dealer-" + std::to_string(i % 5000)));
+        });
+    }
+    for (auto& w : workers) w.join();
+    for (unsigned t = 1; t < threads; ++t) if (ids[t] != ids[0]) return false;
+    return SymbolTable::global().name(ids[0][1234]) == "dealer-1234";
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::size_t before = residentBytes();
+    auto compact = buildInventory<CompactCarBuilder>(count);
+    const std::size_t compactBytes = residentBytes() - before;
+
+    before = residentBytes();
+    auto cars = buildInventory<CarBuilder>(count);
+    const std::size_t carBytes = residentBytes() - before;
+
+    std::cout << "sizeof(Car) = " << sizeof(Car) << ", sizeof(CompactCar) = " << sizeof(CompactCar) << ", "
+              << SymbolTable::global().size() << " symbols" << std::endl;
+    if (carBytes && compactBytes) {
+        std::cout << count << " cars resident: Car " << carBytes / (1024 * 1024) << " MB (" << double(carBytes) / count
+                  << " bytes/car), CompactCar " << compactBytes / (1024 * 1024) << " MB (" << double(compactBytes) / count
+                  << " bytes/car)" << std::endl;
+    }
+
+    // Whole-car equality: three string comparisons and an int, vs. four integer comparisons.
+    const Car& probe = cars[count / 2];
+    const CompactCar& compactProbe = compact[count / 2];
+    std::size_t equal = 0, compactEqual = 0;
+    double equalMs = milliseconds([&] {
+        for (const Car& c : cars) {
+            equal += c.make() == probe.make() && c.model() == probe.model() && c.year() == probe.year() && c.color() == probe.color();
+        }
+    });
+    double compactEqualMs = milliseconds([&] { for (const CompactCar& c : compact) compactEqual += c == compactProbe; });
+    std::cout << "Cars equal to one car: Car " << equalMs << " ms, CompactCar " << compactEqualMs << " ms (" << equal << " / "
+              << compactEqual << " found)" << std::endl;
+
+    // One field: the name is interned once, then only ids are compared.
+    std::size_t byMake = 0, compactByMake = 0;
+    double makeMs = milliseconds([&] { for (const Car& c : cars) byMake += c.make() == "Land Rover"; });
+    double compactMakeMs = milliseconds([&] {
+        const CompactCar::Symbol landRover = SymbolTable::global().intern("Land Rover");
+        for (const CompactCar& c : compact) compactByMake += c.makeSymbol() == landRover;
+    });
+    std::cout << "Cars of one make: Car " << makeMs << " ms, CompactCar " << compactMakeMs << " ms (" << byMake << " / "
+              << compactByMake << " found)" << std::endl;
+
+    std::cout << "Concurrent interning: " << (concurrentInterning() ? "same ids in every thread" : "MISMATCH") << std::endl;
+
+    compact[count / 2].describe();   // The names are only looked up here
+
+    getchar();
+    return 0;
+}
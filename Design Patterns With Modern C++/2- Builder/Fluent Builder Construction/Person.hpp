@@ -0,0 +1,52 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief The "Person" chaining example from "main.cpp", moved into a header so the generic "FluentBuilder<T>" can build it too.
+ *
+ *        Like "Car", its setters take their strings by value (sink parameters) and move them into place.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <utility>
+
+
+class Person {
+public:
+    Person& setName(std::string name) {
+        Name = std::move(name);
+        return *this;  // Return a reference to the current object
+    }
+
+    Person& setAge(int age) {
+        Age = age;
+        return *this;  // Return a reference to the current object
+    }
+
+    Person& setAddress(std::string address) {
+        Address = std::move(address);
+        return *this;  // Return a reference to the current object
+    }
+
+    const std::string& name() const { return Name; }
+    int age() const { return Age; }
+    const std::string& address() const { return Address; }
+
+    void discribe() const {
+        std::cout << "Name: " << Name << std::endl;
+        std::cout << "Age: " << Age << std::endl;
+        std::cout << "Address: " << Address << std::endl;
+    }
+
+private:
+    std::string Name;
+    int Age = 0;
+    std::string Address;
+};
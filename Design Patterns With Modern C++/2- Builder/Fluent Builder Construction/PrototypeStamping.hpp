@@ -0,0 +1,116 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Prototype builders: configure a builder once, then stamp out as many products as needed from it.
+ *
+ *        When thousands of cars only differ by their year or their color, going through a fresh "CarBuilder()" and every setter for
+ *        each of them converts and sets the same make and model strings again and again. A configured builder ("CarBuilder",
+ *        "CompactCarBuilder", any builder whose "build() const" returns the product) is a prototype instead: its product is built once,
+ *        copied "count" times into contiguous storage, and "vary(i, product)" only sets the fields that differ for the i-th copy.
+ *
+ *        - stamp(prototype, count, vector, vary)  : appends the copies to a std::vector with a single reservation.
+ *        - StampArena<Product>::stamp(...)        : places them in an arena: big contiguous chunks that never move (the returned span
+ *                                                   stays valid) and are all released at once with the arena.
+ *
+ *        Usage:
+ *            const CarBuilder suv = CarBuilder().setMake("Land Rover").setModel("Defender 110").setColor("Pangea Green");
+ *            stamp(suv, 1000, cars, [](std::size_t i, Car& car) { car.setYear(2000 + int(i % 25)); });
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+
+// The product a builder makes.
+template <typename Builder>
+using BuiltProduct = std::remove_cvref_t<decltype(std::declval<const Builder&>().build())>;
+
+// Every copy stays exactly like the prototype.
+struct NoVariation {
+    template <typename Product>
+    void operator()(std::size_t, Product&) const {}
+};
+
+template <typename Builder, typename Vary = NoVariation>
+std::span<BuiltProduct<Builder>> stamp(const Builder& prototype, std::size_t count, std::vector<BuiltProduct<Builder>>& out,
+                                       Vary vary = {}) {
+    const BuiltProduct<Builder> product = prototype.build();
+    const std::size_t first = out.size();
+    out.reserve(first + count);
+    for (std::size_t i = 0; i < count; ++i) vary(i, out.emplace_back(product));
+    return std::span<BuiltProduct<Builder>>(out.data() + first, count);
+}
+
+template <typename Product>
+class StampArena {
+public:
+    explicit StampArena(std::size_t chunkCapacity = 64 * 1024) : chunkCapacity_(std::max<std::size_t>(chunkCapacity, 1)) {}
+
+    StampArena(const StampArena&) = delete;
+    StampArena& operator=(const StampArena&) = delete;
+
+    ~StampArena() {
+        std::allocator<Product> allocator;
+        for (auto it = chunks_.rbegin(); it != chunks_.rend(); ++it) {
+            std::destroy(it->items, it->items + it->used);
+            allocator.deallocate(it->items, it->capacity);
+        }
+    }
+
+    // The "count" copies are contiguous: a new chunk is started when the current one cannot hold them all.
+    template <typename Builder, typename Vary = NoVariation>
+    std::span<Product> stamp(const Builder& prototype, std::size_t count, Vary vary = {}) {
+        static_assert(std::is_same_v<BuiltProduct<Builder>, Product>, "StampArena: the builder makes another product");
+        if (count == 0) return {};
+
+        Chunk& chunk = chunkWithRoom(count);
+        const Product product = prototype.build();
+        Product* first = chunk.items + chunk.used;
+        for (std::size_t i = 0; i < count; ++i) {
+            Product* item = std::construct_at(chunk.items + chunk.used, product);
+            ++chunk.used;   // Counted before vary() runs, so the destructor cleans it up even if vary() throws
+            vary(i, *item);
+        }
+        size_ += count;
+        return std::span<Product>(first, count);
+    }
+
+    std::size_t size() const { return size_; }
+
+private:
+    struct Chunk {
+        Product* items;
+        std::size_t capacity;
+        std::size_t used;
+    };
+
+    Chunk& chunkWithRoom(std::size_t count) {
+        if (chunks_.empty() || chunks_.back().capacity - chunks_.back().used < count) {
+            const std::size_t capacity = std::max(chunkCapacity_, count);
+            Product* items = std::allocator<Product>().allocate(capacity);
+            try {
+                chunks_.push_back(Chunk{items, capacity, 0});   // Grows geometrically
+            } catch (...) {
+                std::allocator<Product>().deallocate(items, capacity);
+                throw;
+            }
+        }
+        return chunks_.back();
+    }
+
+    std::size_t chunkCapacity_;
+    std::size_t size_ = 0;
+    std::vector<Chunk> chunks_;
+};
@@ -0,0 +1,192 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Throughput of "Serialization.hpp" for 1M Cars and 1M Persons, in MB/s of encoded data:
+ *
+ *        - binary and JSON, batch encode into a reused "WireBuffer" and batch decode into reused views,
+ *        - the usual way for comparison: one std::ostringstream and one escaped std::string per object,
+ *        - the JSON escaping alone, byte by byte vs 16 bytes at a time (SSE2),
+ *
+ *        with the heap allocations per object of each (counted by "AllocationCounter.hpp"), after a first warm-up batch.
+ *        Every decoded batch is checked against the original objects.
+ *
+ *        Build: g++ -std=c++20 -O2 "Serialization Benchmark.cpp" -o SerializationBenchmark
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <chrono>
+
+#include "Serialization.hpp"
+#include "../../Utilities/AllocationCounter.hpp"
+
+
+static const char* makes[] = {"Toyota", "Mercedes-Benz", "Land Rover", "Volkswagen", "BMW", "Hyundai"};
+static const char* models[] = {"Land Cruiser Prado", "E-Class Estate All-Terrain", "Defender 110 \"Works V8\"", "Golf GTI Clubsport",
+                               "X6", "Tucson Hybrid\tN Line"};
+static const char* colors[] = {"Selenite Grey Metallic", "White", "Pangea Green Metallic", "Kings Red", "Black Sapphire", "Blue"};
+static const char* names[] = {"Ahmad", "Mariam Abdelrahman", "Youssef", "Nour El-Din Hassan", "Salma", "Omar \"Bob\" Khaled"};
+static const char* addresses[] = {"123 Main Street, Anytown, Some Country", "Flat 4, 17 Nile Corniche\nGarden City, Cairo",
+                                  "9 Rue de la Paix, 75002 Paris", "Apartment 1201, Tower B, Smart Village, Giza, Egypt"};
+
+static std::vector<Car> makeCars(std::size_t count) {
+    std::vector<Car> cars;
+    cars.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        cars.push_back(CarBuilder().setMake(makes[i % 6]).setModel(models[i / 6 % 6]).setYear(1990 + int(i % 36)).setColor(colors[i / 36 % 6]).build());
+    }
+    return cars;
+}
+
+static std::vector<Person> makePeople(std::size_t count) {
+    std::vector<Person> people(count);
+    for (std::size_t i = 0; i < count; ++i) people[i].setName(names[i % 6]).setAge(int(i % 90)).setAddress(addresses[i / 6 % 4]);
+    return people;
+}
+
+static bool same(const CarView& view, const Car& car) {
+    return view.make == car.make() && view.model == car.model() && view.year == car.year() && view.color == car.color();
+}
+
+static bool same(const PersonView& view, const Person& person) {
+    return view.name == person.name() && view.age == person.age() && view.address == person.address();
+}
+
+template <typename View, typename Product>
+static bool sameBatch(const std::vector<View>& views, const std::vector<Product>& objects) {
+    if (views.size() != objects.size()) return false;
+    for (std::size_t i = 0; i < views.size(); ++i) if (!same(views[i], objects[i])) return false;
+    return true;
+}
+
+// The usual way: a stream and a few strings per object.
+static std::string naiveEscape(const std::string& s) {
+    std::string escaped;
+    for (char c : s) {
+        switch (c) {
+            case '"':  escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:   escaped += c;
+        }
+    }
+    return escaped;
+}
+
+static std::string naiveJson(const Car& car) {
+    std::ostringstream json;
+    json << R"({"make":")" << naiveEscape(car.make()) << R"(","model":")" << naiveEscape(car.model()) << R"(","year":)" << car.year()
+         << R"(,"color":")" << naiveEscape(car.color()) << "\"}";
+    return json.str();
+}
+
+static std::string naiveJson(const Person& person) {
+    std::ostringstream json;
+    json << R"({"name":")" << naiveEscape(person.name()) << R"(","age":)" << person.age() << R"(,"address":")"
+         << naiveEscape(person.address()) << "\"}";
+    return json.str();
+}
+
+// Best of 3 runs after a warm-up run; "bytes" is what one run produces or consumes.
+template <typename Body>
+static void measure(const char* name, std::size_t objects, Body body) {
+    std::size_t bytes = body();
+    double best = 1e300;
+    std::size_t allocations0 = AllocationCounter::allocations();
+    for (int run = 0; run < 3; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        bytes = body();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::printf("  %-30s %8.1f MB/s  %6.1f ns/object  %5.2f allocations/object\n", name, bytes / best / 1e6, best * 1e9 / objects,
+                double(AllocationCounter::allocations() - allocations0) / 3 / objects);
+}
+
+template <typename Product, typename View>
+static void compare(const char* product, const std::vector<Product>& objects) {
+    const std::size_t count = objects.size();
+    WireBuffer binary, json;
+    std::vector<View> views;
+    std::string scratch;
+    bool ok = true;
+
+    std::printf("%s (%zu objects):\n", product, count);
+    measure("binary encode", count, [&] {
+        binary.clear();
+        encodeBinary(std::span<const Product>(objects), binary);
+        return binary.size();
+    });
+    measure("binary decode (views)", count, [&] {
+        decodeBinary(binary.view(), views);
+        return binary.size();
+    });
+    ok = ok && sameBatch(views, objects);
+
+    measure("JSON encode", count, [&] {
+        json.clear();
+        encodeJson(std::span<const Product>(objects), json);
+        return json.size();
+    });
+    measure("JSON decode (views)", count, [&] {
+        decodeJson(json.view(), views, scratch);
+        return json.size();
+    });
+    ok = ok && sameBatch(views, objects);
+
+    measure("JSON, ostringstream per object", count, [&] {
+        std::string all = "[";
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i) all += ',';
+            all += naiveJson(objects[i]);
+        }
+        all += ']';
+        ok = ok && all == json.view();
+        return all.size();
+    });
+
+    std::printf("  binary %.1f MB, JSON %.1f MB, round trips %s\n\n", binary.size() / 1e6, json.size() / 1e6, ok ? "OK" : "WRONG");
+}
+
+int main() {
+    const std::size_t count = 1000000;
+    const std::vector<Car> cars = makeCars(count);
+    const std::vector<Person> people = makePeople(count);
+
+    compare<Car, CarView>("Car", cars);
+    compare<Person, PersonView>("Person", people);
+
+    // The escaping alone, over every string of the people (the addresses are 29 to 51 bytes long).
+    std::vector<std::string_view> strings;
+    std::size_t length = 0;
+    for (const Person& person : people) {
+        strings.push_back(person.name());
+        strings.push_back(person.address());
+        length += person.name().size() + person.address().size();
+    }
+    std::vector<char> escaped(length * serialization_detail::MaxEscapedPerByte);
+    std::printf("JSON escaping (%.1f MB of names and addresses):\n", length / 1e6);
+    measure("byte by byte", count, [&] {
+        char* out = escaped.data();
+        for (std::string_view s : strings) out = serialization_detail::escapeScalar(out, s);
+        return length;
+    });
+    measure("16 bytes at a time (SSE2)", count, [&] {
+        char* out = escaped.data();
+        for (std::string_view s : strings) out = serialization_detail::escape(out, s);
+        return length;
+    });
+
+    getchar();
+    return 0;
+}
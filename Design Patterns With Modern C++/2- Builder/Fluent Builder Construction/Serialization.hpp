@@ -0,0 +1,585 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Shipping built "Car"s and "Person"s to other services: a compact binary format and JSON, written into reusable buffers.
+ *
+ *        describe() / discribe() are for humans: text to std::cout, flushed after every field. These functions are for programs:
+ *
+ *          - encodeBinary(object or span, buffer) : appends the binary form (below) to a "WireBuffer".
+ *          - encodeJson(object or span, buffer)   : appends the JSON form, {"make":"Toyota","model":"Camry","year":2023,"color":"Blue"}
+ *                                                   for one object, [{...},{...}] for a span.
+ *          - decodeBinary(bytes, views)           : decodes a batch written by encodeBinary(span) into "CarView"s / "PersonView"s,
+ *          - decodeJson(text, views, scratch)       and one written by encodeJson(span) (any JSON array of such objects, in fact).
+ *
+ *        No allocation per object, on either side:
+ *          - A "WireBuffer" only grows (doubling, never zero-filled): clear() it and encode the next batch into the same memory.
+ *            A batch is measured first, so its binary form is written with at most one growth.
+ *          - A decoded object is a view: its strings point into the input (binary, and JSON strings without escapes) or into the
+ *            caller's "scratch" string (unescaped JSON strings). "views" and "scratch" are cleared and reused, so once they are big
+ *            enough, decoding allocates nothing. toCar() / toPerson() make owning objects when needed.
+ *          - JSON escaping checks 16 bytes at a time with SSE2 (always there on x86-64): a run of 16 bytes without a quote, a
+ *            backslash or a control character is copied as one block. Other targets use the byte-by-byte loop.
+ *
+ *        Binary format (little-endian base-128 varints, the way Protocol Buffers does it):
+ *            batch  = count, record * count
+ *            Car    = string make, string model, zigzag year, string color
+ *            Person = string name, zigzag age, string address
+ *            string = length, bytes
+ *
+ *        Malformed input throws std::invalid_argument, like buildCars().
+ *
+ *        Build (any file including this header): g++ -std=c++20 <file>.cpp   (see "Serialization Benchmark.cpp")
+ */
+
+#pragma once
+
+#include <span>
+#include <bit>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SERIALIZATION_SSE2 1
+#endif
+
+#include "CarBuilder.hpp"
+#include "Person.hpp"
+
+
+// A growable byte buffer that keeps its memory between batches and never initializes what it is about to overwrite.
+class WireBuffer {
+public:
+    std::string_view view() const { return std::string_view(data_.get(), size_); }
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    void clear() { size_ = 0; }
+
+    // At least "bytes" writable bytes at the end of the buffer, made part of it by commit(end of what was written).
+    char* prepare(std::size_t bytes) {
+        if (capacity_ - size_ < bytes) {
+            const std::size_t capacity = std::max(capacity_ * 2, size_ + bytes);
+            std::unique_ptr<char[]> data = std::make_unique_for_overwrite<char[]>(capacity);
+            if (size_) std::memcpy(data.get(), data_.get(), size_);
+            data_ = std::move(data);
+            capacity_ = capacity;
+        }
+        return data_.get() + size_;
+    }
+
+    void commit(char* end) { size_ = static_cast<std::size_t>(end - data_.get()); }
+
+private:
+    std::unique_ptr<char[]> data_;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+// A decoded Car / Person: its strings point into the decoded input (or the JSON scratch string), which must outlive it.
+struct CarView {
+    std::string_view make;
+    std::string_view model;
+    int year = 0;
+    std::string_view color;
+
+    Car toCar() const {
+        Car car;
+        car.setMake(std::string(make));
+        car.setModel(std::string(model));
+        car.setYear(year);
+        car.setColor(std::string(color));
+        return car;
+    }
+};
+
+struct PersonView {
+    std::string_view name;
+    int age = 0;
+    std::string_view address;
+
+    Person toPerson() const {
+        Person person;
+        person.setName(std::string(name)).setAge(age).setAddress(std::string(address));
+        return person;
+    }
+};
+
+
+namespace serialization_detail {
+    // ---------------------------------------------------------------- Binary
+
+    inline std::size_t varintSize(std::uint64_t value) {
+        return value < 0x80 ? 1 : (std::bit_width(value) + 6) / 7;
+    }
+
+    inline std::uint64_t zigzag(int value) {
+        return (static_cast<std::uint64_t>(static_cast<std::int64_t>(value)) << 1) ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(value) >> 63);
+    }
+
+    inline int unzigzag(std::uint64_t value) {
+        return static_cast<int>(static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1));
+    }
+
+    inline char* putVarint(char* out, std::uint64_t value) {
+        while (value >= 0x80) {
+            *out++ = static_cast<char>(value | 0x80);
+            value >>= 7;
+        }
+        *out++ = static_cast<char>(value);
+        return out;
+    }
+
+    inline char* putString(char* out, std::string_view s) {
+        out = putVarint(out, s.size());
+        std::memcpy(out, s.data(), s.size());
+        return out + s.size();
+    }
+
+    inline std::size_t stringSize(std::string_view s) { return varintSize(s.size()) + s.size(); }
+
+    inline std::size_t binarySize(const Car& car) {
+        return stringSize(car.make()) + stringSize(car.model()) + varintSize(zigzag(car.year())) + stringSize(car.color());
+    }
+
+    inline std::size_t binarySize(const Person& person) {
+        return stringSize(person.name()) + varintSize(zigzag(person.age())) + stringSize(person.address());
+    }
+
+    inline char* putBinary(char* out, const Car& car) {
+        out = putString(out, car.make());
+        out = putString(out, car.model());
+        out = putVarint(out, zigzag(car.year()));
+        return putString(out, car.color());
+    }
+
+    inline char* putBinary(char* out, const Person& person) {
+        out = putString(out, person.name());
+        out = putVarint(out, zigzag(person.age()));
+        return putString(out, person.address());
+    }
+
+    [[noreturn]] inline void malformed(const char* what) {
+        throw std::invalid_argument(std::string("Serialization: malformed input, ") + what);
+    }
+
+    class BinaryReader {
+    public:
+        explicit BinaryReader(std::string_view in) : p_(in.data()), end_(in.data() + in.size()) {}
+
+        std::uint64_t varint() {
+            std::uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (p_ == end_) malformed("truncated varint");
+                const auto byte = static_cast<unsigned char>(*p_++);
+                value |= std::uint64_t(byte & 0x7F) << shift;
+                if (byte < 0x80) return value;
+            }
+            malformed("varint longer than 64 bits");
+        }
+
+        std::string_view string() {
+            const std::uint64_t size = varint();
+            if (size > static_cast<std::uint64_t>(end_ - p_)) malformed("string past the end of the input");
+            std::string_view s(p_, static_cast<std::size_t>(size));
+            p_ += size;
+            return s;
+        }
+
+        std::size_t remaining() const { return static_cast<std::size_t>(end_ - p_); }
+
+    private:
+        const char* p_;
+        const char* end_;
+    };
+
+    inline void readBinary(BinaryReader& in, CarView& car) {
+        car.make = in.string();
+        car.model = in.string();
+        car.year = unzigzag(in.varint());
+        car.color = in.string();
+    }
+
+    inline void readBinary(BinaryReader& in, PersonView& person) {
+        person.name = in.string();
+        person.age = unzigzag(in.varint());
+        person.address = in.string();
+    }
+
+    template <typename View>
+    void decodeBinaryBatch(std::string_view in, std::vector<View>& out) {
+        BinaryReader reader(in);
+        const std::uint64_t count = reader.varint();
+        if (count > reader.remaining()) malformed("count larger than the input");   // Every record is at least 1 byte
+        out.clear();
+        out.resize(static_cast<std::size_t>(count));
+        for (View& view : out) readBinary(reader, view);
+        if (reader.remaining() != 0) malformed("bytes after the last record");
+    }
+
+    // ---------------------------------------------------------------- JSON
+
+    // The longest escape is "\u001f" for one byte.
+    constexpr std::size_t MaxEscapedPerByte = 6;
+
+    inline bool needsEscape(unsigned char c) { return c == '"' || c == '\\' || c < 0x20; }
+
+    inline char* escapeByte(char* out, unsigned char c) {
+        static constexpr char hex[] = "0123456789abcdef";
+        *out++ = '\\';
+        switch (c) {
+            case '"':  *out++ = '"';  break;
+            case '\\': *out++ = '\\'; break;
+            case '\b': *out++ = 'b';  break;
+            case '\f': *out++ = 'f';  break;
+            case '\n': *out++ = 'n';  break;
+            case '\r': *out++ = 'r';  break;
+            case '\t': *out++ = 't';  break;
+            default:
+                std::memcpy(out, "u00", 3);
+                out[3] = hex[c >> 4];
+                out[4] = hex[c & 0xF];
+                out += 5;
+        }
+        return out;
+    }
+
+    inline char* escapeScalar(char* out, std::string_view s) {
+        for (char ch : s) {
+            const auto c = static_cast<unsigned char>(ch);
+            if (needsEscape(c)) out = escapeByte(out, c);
+            else *out++ = ch;
+        }
+        return out;
+    }
+
+#ifdef SERIALIZATION_SSE2
+    // Bit i is set when byte i of the 16 at "p" is a quote, a backslash or a control character (<= 0x1F, compared unsigned).
+    inline unsigned specialMask(const char* p, bool controls) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')));
+        if (controls) {
+            const __m128i control = _mm_set1_epi8(0x1F);
+            special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+        }
+        return static_cast<unsigned>(_mm_movemask_epi8(special));
+    }
+#endif
+
+    // Needs MaxEscapedPerByte * s.size() bytes at "out" (the 16-byte copies below never go past that).
+    inline char* escape(char* out, std::string_view s) {
+#ifdef SERIALIZATION_SSE2
+        const char* p = s.data();
+        const char* const end = p + s.size();
+        while (end - p >= 16) {
+            const unsigned mask = specialMask(p, true);
+            std::memcpy(out, p, 16);   // Copied optimistically, the part after the first special byte is overwritten
+            if (mask == 0) {
+                out += 16;
+                p += 16;
+                continue;
+            }
+            const int clean = std::countr_zero(mask);
+            out = escapeByte(out + clean, static_cast<unsigned char>(p[clean]));
+            p += clean + 1;
+        }
+        return escapeScalar(out, std::string_view(p, static_cast<std::size_t>(end - p)));
+#else
+        return escapeScalar(out, s);
+#endif
+    }
+
+    inline char* putJsonString(char* out, std::string_view s) {
+        *out++ = '"';
+        out = escape(out, s);
+        *out++ = '"';
+        return out;
+    }
+
+    template <std::size_t N>
+    inline char* putLiteral(char* out, const char (&literal)[N]) {
+        std::memcpy(out, literal, N - 1);
+        return out + N - 1;
+    }
+
+    inline char* putInt(char* out, int value) {
+        return std::to_chars(out, out + 11, value).ptr;
+    }
+
+    inline std::size_t jsonMaxSize(const Car& car) {
+        return sizeof(R"({"make":"","model":"","year":,"color":""})") + 11 +
+               MaxEscapedPerByte * (car.make().size() + car.model().size() + car.color().size());
+    }
+
+    inline std::size_t jsonMaxSize(const Person& person) {
+        return sizeof(R"({"name":"","age":,"address":""})") + 11 +
+               MaxEscapedPerByte * (person.name().size() + person.address().size());
+    }
+
+    inline char* putJson(char* out, const Car& car) {
+        out = putLiteral(out, R"({"make":)");
+        out = putJsonString(out, car.make());
+        out = putLiteral(out, R"(,"model":)");
+        out = putJsonString(out, car.model());
+        out = putLiteral(out, R"(,"year":)");
+        out = putInt(out, car.year());
+        out = putLiteral(out, R"(,"color":)");
+        out = putJsonString(out, car.color());
+        *out++ = '}';
+        return out;
+    }
+
+    inline char* putJson(char* out, const Person& person) {
+        out = putLiteral(out, R"({"name":)");
+        out = putJsonString(out, person.name());
+        out = putLiteral(out, R"(,"age":)");
+        out = putInt(out, person.age());
+        out = putLiteral(out, R"(,"address":)");
+        out = putJsonString(out, person.address());
+        *out++ = '}';
+        return out;
+    }
+
+    inline void appendUtf8(std::string& out, std::uint32_t code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    // Reads the subset of JSON the encoders write: an array of flat objects with string and integer values, any whitespace.
+    class JsonReader {
+    public:
+        // Unescaped strings go to "scratch", reserved up front so the views into it stay valid (unescaping never makes text longer).
+        JsonReader(std::string_view in, std::string& scratch) : in_(in), scratch_(scratch) {
+            scratch_.clear();
+            scratch_.reserve(in.size());
+        }
+
+        bool consume(char c) {
+            skipSpace();
+            if (pos_ < in_.size() && in_[pos_] == c) {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+
+        void expect(char c) {
+            if (!consume(c)) malformed("unexpected character in JSON");
+        }
+
+        void expectEnd() {
+            skipSpace();
+            if (pos_ != in_.size()) malformed("text after the JSON array");
+        }
+
+        std::string_view string() {
+            expect('"');
+            const std::size_t start = pos_;
+            skipPlain();
+            if (pos_ >= in_.size()) malformed("unterminated JSON string");
+            if (in_[pos_] == '"') return in_.substr(start, pos_++ - start);   // No escapes: a view of the input
+
+            const std::size_t first = scratch_.size();
+            scratch_.append(in_, start, pos_ - start);
+            while (true) {
+                if (pos_ >= in_.size()) malformed("unterminated JSON string");
+                const char c = in_[pos_++];
+                if (c == '"') break;
+                if (c == '\\') {
+                    unescapeOne();
+                    continue;
+                }
+                const std::size_t run = pos_ - 1;
+                skipPlain();
+                scratch_.append(in_, run, pos_ - run);
+            }
+            return std::string_view(scratch_).substr(first);
+        }
+
+        int integer() {
+            skipSpace();
+            int value = 0;
+            const auto [end, error] = std::from_chars(in_.data() + pos_, in_.data() + in_.size(), value);
+            if (error != std::errc()) malformed("bad JSON integer");
+            pos_ = static_cast<std::size_t>(end - in_.data());
+            return value;
+        }
+
+    private:
+        void skipSpace() {
+            while (pos_ < in_.size() && (in_[pos_] == ' ' || in_[pos_] == '\n' || in_[pos_] == '\r' || in_[pos_] == '\t')) ++pos_;
+        }
+
+        // Up to the next quote or backslash (16 bytes at a time with SSE2).
+        void skipPlain() {
+#ifdef SERIALIZATION_SSE2
+            while (in_.size() - pos_ >= 16) {
+                if (const unsigned mask = specialMask(in_.data() + pos_, false)) {
+                    pos_ += static_cast<std::size_t>(std::countr_zero(mask));
+                    return;
+                }
+                pos_ += 16;
+            }
+#endif
+            while (pos_ < in_.size() && in_[pos_] != '"' && in_[pos_] != '\\') ++pos_;
+        }
+
+        std::uint32_t hex4() {
+            if (in_.size() - pos_ < 4) malformed("truncated \\u escape");
+            std::uint32_t value = 0;
+            const auto [end, error] = std::from_chars(in_.data() + pos_, in_.data() + pos_ + 4, value, 16);
+            if (error != std::errc() || end != in_.data() + pos_ + 4) malformed("bad \\u escape");
+            pos_ += 4;
+            return value;
+        }
+
+        void unescapeOne() {
+            if (pos_ >= in_.size()) malformed("truncated escape");
+            switch (const char c = in_[pos_++]) {
+                case '"': case '\\': case '/': scratch_ += c; break;
+                case 'b': scratch_ += '\b'; break;
+                case 'f': scratch_ += '\f'; break;
+                case 'n': scratch_ += '\n'; break;
+                case 'r': scratch_ += '\r'; break;
+                case 't': scratch_ += '\t'; break;
+                case 'u': {
+                    std::uint32_t code = hex4();
+                    if (code >= 0xD800 && code < 0xDC00 && in_.substr(pos_, 2) == "\\u") {   // Surrogate pair
+                        pos_ += 2;
+                        const std::uint32_t low = hex4();
+                        if (low < 0xDC00 || low >= 0xE000) malformed("bad surrogate pair");
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(scratch_, code);
+                    break;
+                }
+                default: malformed("unknown escape");
+            }
+        }
+
+        std::string_view in_;
+        std::size_t pos_ = 0;
+        std::string& scratch_;
+    };
+
+    inline void readField(JsonReader& in, std::string_view key, CarView& car) {
+        if (key == "make") car.make = in.string();
+        else if (key == "model") car.model = in.string();
+        else if (key == "year") car.year = in.integer();
+        else if (key == "color") car.color = in.string();
+        else malformed("unknown Car field");
+    }
+
+    inline void readField(JsonReader& in, std::string_view key, PersonView& person) {
+        if (key == "name") person.name = in.string();
+        else if (key == "age") person.age = in.integer();
+        else if (key == "address") person.address = in.string();
+        else malformed("unknown Person field");
+    }
+
+    template <typename View>
+    void decodeJsonBatch(std::string_view in, std::vector<View>& out, std::string& scratch) {
+        JsonReader reader(in, scratch);
+        out.clear();
+        reader.expect('[');
+        if (!reader.consume(']')) {
+            do {
+                View& view = out.emplace_back();
+                reader.expect('{');
+                if (!reader.consume('}')) {
+                    do {
+                        const std::string_view key = reader.string();
+                        reader.expect(':');
+                        readField(reader, key, view);
+                    } while (reader.consume(','));
+                    reader.expect('}');
+                }
+            } while (reader.consume(','));
+            reader.expect(']');
+        }
+        reader.expectEnd();
+    }
+
+    template <typename Product>
+    void encodeBinaryBatch(std::span<const Product> objects, WireBuffer& out) {
+        std::size_t size = varintSize(objects.size());
+        for (const Product& object : objects) size += binarySize(object);
+        char* p = putVarint(out.prepare(size), objects.size());
+        for (const Product& object : objects) p = putBinary(p, object);
+        out.commit(p);
+    }
+
+    template <typename Product>
+    void encodeJsonBatch(std::span<const Product> objects, WireBuffer& out) {
+        char* p = out.prepare(1);
+        *p++ = '[';
+        out.commit(p);
+        for (std::size_t i = 0; i < objects.size(); ++i) {
+            p = out.prepare(jsonMaxSize(objects[i]) + 1);
+            if (i) *p++ = ',';
+            out.commit(putJson(p, objects[i]));
+        }
+        p = out.prepare(1);
+        *p++ = ']';
+        out.commit(p);
+    }
+}
+
+
+inline void encodeBinary(const Car& car, WireBuffer& out) {
+    out.commit(serialization_detail::putBinary(out.prepare(serialization_detail::binarySize(car)), car));
+}
+
+inline void encodeBinary(const Person& person, WireBuffer& out) {
+    out.commit(serialization_detail::putBinary(out.prepare(serialization_detail::binarySize(person)), person));
+}
+
+inline void encodeBinary(std::span<const Car> cars, WireBuffer& out) { serialization_detail::encodeBinaryBatch(cars, out); }
+inline void encodeBinary(std::span<const Person> people, WireBuffer& out) { serialization_detail::encodeBinaryBatch(people, out); }
+
+inline void encodeJson(const Car& car, WireBuffer& out) {
+    out.commit(serialization_detail::putJson(out.prepare(serialization_detail::jsonMaxSize(car)), car));
+}
+
+inline void encodeJson(const Person& person, WireBuffer& out) {
+    out.commit(serialization_detail::putJson(out.prepare(serialization_detail::jsonMaxSize(person)), person));
+}
+
+inline void encodeJson(std::span<const Car> cars, WireBuffer& out) { serialization_detail::encodeJsonBatch(cars, out); }
+inline void encodeJson(std::span<const Person> people, WireBuffer& out) { serialization_detail::encodeJsonBatch(people, out); }
+
+// "cars" / "people" are replaced by the decoded batch; their capacity (and the scratch string's) is reused.
+inline void decodeBinary(std::string_view in, std::vector<CarView>& cars) { serialization_detail::decodeBinaryBatch(in, cars); }
+inline void decodeBinary(std::string_view in, std::vector<PersonView>& people) { serialization_detail::decodeBinaryBatch(in, people); }
+
+inline void decodeJson(std::string_view in, std::vector<CarView>& cars, std::string& scratch) {
+    serialization_detail::decodeJsonBatch(in, cars, scratch);
+}
+
+inline void decodeJson(std::string_view in, std::vector<PersonView>& people, std::string& scratch) {
+    serialization_detail::decodeJsonBatch(in, people, scratch);
+}
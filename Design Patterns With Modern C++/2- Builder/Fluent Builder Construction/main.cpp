@@ -12,6 +12,9 @@
 #include <vector>
 #include <fstream>
 
+#include "CarBuilder.hpp"  // Build with: g++ -std=c++20 main.cpp
+#include "Person.hpp"
+
 
 /**
  * \brief  The Builder pattern is a powerful design pattern for constructing complex objects with multiple configuration options.
@@ -30,62 +33,16 @@
 
 
 
-// Product: Car class representing the complex object to be built
-class Car {
-public:
-
-    // Elements Setters:
-    void setMake(const std::string& make) { make_ = make; }
-    void setModel(const std::string& model) { model_ = model; }
-    void setYear(int year) { year_ = year; }
-    void setColor(const std::string& color) { color_ = color; }
-
-    void describe() const {
-        std::cout << "Car Details:" << std::endl;
-        std::cout << "Make: " << make_ << std::endl;
-        std::cout << "Model: " << model_ << std::endl;
-        std::cout << "Year: " << year_ << std::endl;
-        std::cout << "Color: " << color_ << std::endl;
-    }
-
-private:
-    // These are the elements that will be configuered (built) by the builder class.
-    std::string make_;
-    std::string model_;
-    int year_ = 0;
-    std::string color_;
-};
-
-// Fluent Builder: Provides a fluent interface for configuring a Car object
-class CarBuilder {
-public:
-    CarBuilder& setMake(const std::string& make) {
-        car_.setMake(make);
-        return *this; // Return a reference to the current builder
-    }
-
-    CarBuilder& setModel(const std::string& model) {
-        car_.setModel(model);
-        return *this;
-    }
-
-    CarBuilder& setYear(int year) {
-        car_.setYear(year);
-        return *this;
-    }
-
-    CarBuilder& setColor(const std::string& color) {
-        car_.setColor(color);
-        return *this;
-    }
-
-    Car build() {
-        return car_; // Return the constructed Car object
-    }
-
-private:
-    Car car_; // The Car object being constructed
-};
+// The product "Car" and its Fluent Builder "CarBuilder" live in "CarBuilder.hpp" so the other examples of this folder can reuse them:
+//
+//   - Car        : The complex object, a Setter for each of its elements (sink parameters, moved into place).
+//   - CarBuilder : The Fluent Builder, every setter returns the builder so the calls can be chained, and "build() &&" moves
+//                  the Car out of a temporary builder instead of copying it.
+//   - buildCars(): Builds a "std::vector<Car>" from CSV rows in one go (see "Builder Benchmark.cpp").
+//
+// "CompactCar.hpp" has the same product for huge inventories: interned 32-bit symbols instead of strings ("CompactCarBuilder").
+// "PrototypeStamping.hpp" turns a configured builder into a prototype, stamped out N times into a vector or an arena.
+// "Serialization.hpp" ships built Cars and Persons to other programs: binary and JSON, batch encode/decode into reused buffers.
 
 
 
@@ -93,7 +50,7 @@ private:
  *  \brief   The Fluent Builder class will use the complex class methods. The Fluent Builder class that enables method chaining for configuring a Car object. 
  *           Each setter method returns a reference to the current builder (*this), allowing subsequent method calls to be ">>chained<<" together.
  *           
- *           Note: Please jumb to line 120 if you do not know what "chaining" means.
+ *           Note: Please jumb to line 86 if you do not know what "chaining" means.
 */
 
 void main_chain();
@@ -136,34 +93,12 @@ int main() {
  * 
 */
 
-class Person {
-public:
-    Person& setName(const std::string& name) {
-        Name = name;
-        return *this;  // Return a reference to the current object
-    }
-
-    Person& setAge(int age) {
-        Age = age;
-        return *this;  // Return a reference to the current object
-    }
-
-    Person& setAddress(const std::string& address) {
-        Address = address;
-        return *this;  // Return a reference to the current object
-    }
-
-    void discribe() const {
-        std::cout << "Name: " << Name << std::endl;
-        std::cout << "Age: " << Age << std::endl;
-        std::cout << "Address: " << Address << std::endl;
-    }
-
-private:
-    std::string Name;
-    int Age;
-    std::string Address;
-};
+// Every setter of "Person" (in "Person.hpp") returns a reference to the current object (*this), so the calls can be chained:
+//
+//     Person& setName(std::string name) {
+//         Name = std::move(name);
+//         return *this;  // Return a reference to the current object
+//     }
 
 void main_chain() {
     // Create a Person object and use chaining to set attributes
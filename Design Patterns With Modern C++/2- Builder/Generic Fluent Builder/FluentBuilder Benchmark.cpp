@@ -0,0 +1,122 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Does "FluentBuilder<T>" cost anything compared to setting the fields by hand?
+ *
+ *        For Car and Person, the same object is made three ways from the same (moved) strings:
+ *          - viaSetters         : a default-constructed object and its setters, the code we would write without a builder,
+ *          - viaHandWritten     : the hand-written builder ("CarBuilder", or Person's own chained setters),
+ *          - viaFluentBuilder   : "FluentBuilder<T, ...>".
+ *
+ *        1) Machine code: the functions are kept out of line, compare them (and count their instructions) with
+ *               g++ -std=c++20 -O2 -c "FluentBuilder Benchmark.cpp" -o bench.o
+ *               objdump -d --no-show-raw-insn -C bench.o | awk '/<via/,/^$/'
+ *               objdump -d --no-show-raw-insn -C bench.o | awk '/^[0-9a-f]+ <via/ { if (name) print count, name; name = $0; count = 0; next }
+ *                                                             /^$/ { if (name) print count, name; name = ""; next } name { count++ }'
+ *           With g++ 12 -O2 on x86-64, instructions per function:
+ *
+ *                                    Car   Person
+ *               viaSetters           293      207
+ *               viaHandWritten       497      205
+ *               viaFluentBuilder     293      208
+ *
+ *           viaFluentBuilder makes the same setter calls as viaSetters, and the temporary builder leaves no code behind (it never
+ *           made a product). The code is still not identical: the result is value-initialized ("T{}", the object is zeroed before
+ *           its members are constructed, which "Car car;" skips), and the chain keeps each argument's address, so "year" goes
+ *           through the stack. With "Car car{};" in viaSetters, only register moves and stack offsets differ. The hand-written
+ *           CarBuilder also moves every string a second time in build().
+ *        2) Time per object over 10M objects (a strings-heavy object costs ~70-100 ns here, most of it malloc): FluentBuilder is within
+ *           the run-to-run noise of the setters for both products (Car 74-103 ns vs 74-104 ns, Person 46-62 ns vs 45-65 ns), the
+ *           hand-written CarBuilder is 5-25 ns slower.
+ *
+ *        Build: g++ -std=c++20 -O2 "FluentBuilder Benchmark.cpp" -o FluentBuilderBenchmark
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <chrono>
+
+#include "FluentBuilder.hpp"
+#include "../Fluent Builder Construction/CarBuilder.hpp"
+#include "../Fluent Builder Construction/Person.hpp"
+
+
+using GenericCarBuilder = FluentBuilder<Car, &Car::setMake, &Car::setModel, &Car::setYear, &Car::setColor>;
+using GenericPersonBuilder = FluentBuilder<Person, &Person::setName, &Person::setAge, &Person::setAddress>;
+
+[[gnu::noinline]] Car viaSetters(std::string make, std::string model, int year, std::string color) {
+    Car car;
+    car.setMake(std::move(make));
+    car.setModel(std::move(model));
+    car.setYear(year);
+    car.setColor(std::move(color));
+    return car;
+}
+
+[[gnu::noinline]] Car viaHandWritten(std::string make, std::string model, int year, std::string color) {
+    return CarBuilder().setMake(std::move(make)).setModel(std::move(model)).setYear(year).setColor(std::move(color)).build();
+}
+
+[[gnu::noinline]] Car viaFluentBuilder(std::string make, std::string model, int year, std::string color) {
+    return GenericCarBuilder()
+            .set<&Car::setMake>(std::move(make))
+            .set<&Car::setModel>(std::move(model))
+            .set<&Car::setYear>(year)
+            .set<&Car::setColor>(std::move(color))
+            .build();
+}
+
+[[gnu::noinline]] Person viaSetters(std::string name, int age, std::string address) {
+    Person person;
+    person.setName(std::move(name));
+    person.setAge(age);
+    person.setAddress(std::move(address));
+    return person;
+}
+
+[[gnu::noinline]] Person viaHandWritten(std::string name, int age, std::string address) {
+    Person person;
+    person.setName(std::move(name)).setAge(age).setAddress(std::move(address));
+    return person;
+}
+
+[[gnu::noinline]] Person viaFluentBuilder(std::string name, int age, std::string address) {
+    return GenericPersonBuilder()
+            .set<&Person::setName>(std::move(name))
+            .set<&Person::setAge>(age)
+            .set<&Person::setAddress>(std::move(address))
+            .build();
+}
+
+template <typename Make>
+static double nanosecondsPerObject(Make make, int count) {
+    std::size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) checksum += make(i);
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+    if (checksum == 42) std::cout << "";   // Keeps the results alive
+    return ns;
+}
+
+int main() {
+    const int count = 10000000;
+    const std::string make = "Mercedes-Benz", model = "E-Class Estate All-Terrain", color = "Selenite Grey Metallic";
+    const std::string name = "Ahmad", address = "123 Main Street, Anytown, Some Country";
+
+    std::cout << "Car    setters       : " << nanosecondsPerObject([&](int i) { return viaSetters(make, model, i, color).model().size(); }, count) << " ns" << std::endl;
+    std::cout << "Car    CarBuilder    : " << nanosecondsPerObject([&](int i) { return viaHandWritten(make, model, i, color).model().size(); }, count) << " ns" << std::endl;
+    std::cout << "Car    FluentBuilder : " << nanosecondsPerObject([&](int i) { return viaFluentBuilder(make, model, i, color).model().size(); }, count) << " ns" << std::endl;
+    std::cout << "Person setters       : " << nanosecondsPerObject([&](int i) { return viaSetters(name, i, address).address().size(); }, count) << " ns" << std::endl;
+    std::cout << "Person chained       : " << nanosecondsPerObject([&](int i) { return viaHandWritten(name, i, address).address().size(); }, count) << " ns" << std::endl;
+    std::cout << "Person FluentBuilder : " << nanosecondsPerObject([&](int i) { return viaFluentBuilder(name, i, address).address().size(); }, count) << " ns" << std::endl;
+
+    getchar();
+    return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+
+#include "FluentBuilder.hpp"  // Build with: g++ -std=c++20 main.cpp
+#include "../Fluent Builder Construction/CarBuilder.hpp"
+#include "../Fluent Builder Construction/Person.hpp"
+
+
+/**
+ * \brief  The same Fluent Builder for three different products, without writing a builder class for any of them:
+ *
+ *         - Car and Person: through their setters (the members are private).
+ *         - Engine: an aggregate, through its data members.
+ *
+ *         Each builder lists the bindings it allows, anything else is rejected at compile time.
+*/
+
+using GenericCarBuilder = FluentBuilder<Car, &Car::setMake, &Car::setModel, &Car::setYear, &Car::setColor>;
+using GenericPersonBuilder = FluentBuilder<Person, &Person::setName, &Person::setAge, &Person::setAddress>;
+
+struct Engine {
+    int cylinders = 4;
+    double displacement = 2.0;   // Liters
+    std::string fuel = "Petrol";
+};
+
+using EngineBuilder = FluentBuilder<Engine, &Engine::cylinders, &Engine::displacement, &Engine::fuel>;
+
+
+// The builder is the (optional) product and nothing else: the bindings only exist in its type.
+static_assert(sizeof(GenericCarBuilder) == sizeof(std::optional<Car>));
+static_assert(sizeof(GenericPersonBuilder) == sizeof(std::optional<Person>));
+
+// Only the listed bindings can be set.
+static_assert(GenericCarBuilder::isBound<&Car::setMake>);
+static_assert(!GenericCarBuilder::isBound<&Person::setName>);          // Another product's setter
+static_assert(!FluentBuilder<Engine, &Engine::fuel>::isBound<&Engine::cylinders>);   // Not in the list
+
+
+int main() {
+    Car car = GenericCarBuilder()
+                    .set<&Car::setMake>("Toyota")
+                    .set<&Car::setModel>("Camry")
+                    .set<&Car::setYear>(2023)
+                    .set<&Car::setColor>("Blue")
+                    .build();
+
+    Person person = GenericPersonBuilder()
+                    .set<&Person::setName>("Ahmad")
+                    .set<&Person::setAge>(25)
+                    .set<&Person::setAddress>("123 Main St, Anytown")
+                    .build();
+
+    // A named builder keeps its configuration: here it is a template for the V6 variants.
+    EngineBuilder v6;
+    v6.set<&Engine::cylinders>(6).set<&Engine::displacement>(3.5);
+    Engine petrol = v6.build();
+    Engine hybrid = EngineBuilder(v6).set<&Engine::fuel>("Hybrid").build();
+
+    car.describe();
+    person.discribe();
+    std::cout << "Engines: " << petrol.cylinders << " cylinders " << petrol.displacement << " L " << petrol.fuel << ", "
+              << hybrid.cylinders << " cylinders " << hybrid.displacement << " L " << hybrid.fuel << std::endl;
+
+    getchar();
+
+    return 0;
+}
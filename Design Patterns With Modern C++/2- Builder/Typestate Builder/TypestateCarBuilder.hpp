@@ -0,0 +1,112 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Typestate Fluent Builder: the builder's type remembers which fields were set, so a Car with no make, no model or no year
+ *        ("year_ = 0") is a compile error instead of a run-time check.
+ *
+ *        "TypestateCarBuilder<Set>" carries a bit mask of the fields set so far: every setter returns a builder of another type
+ *        ("Set | Field"), and "build()" only exists when the mask holds every required field. Setting a field twice does not compile either.
+ *        All of it lives in the types, at run time the builder is just the "CarSpec" it fills, so a chain compiles to the same code as
+ *        writing the aggregate directly (see "main.cpp").
+ *
+ *        "CarSpec" only holds std::string_view and int, so a configuration made of literals can be built entirely at compile time
+ *        ("constexpr"). The views must outlive the CarSpec: string literals always do. "toCar()" turns it into the "Car" of
+ *        "CarBuilder.hpp", which owns its strings.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "../Fluent Builder Construction/CarBuilder.hpp"
+
+
+// Product of the typestate builder: a literal type, so it can be a constexpr constant.
+struct CarSpec {
+    std::string_view make;
+    std::string_view model;
+    int year = 0;
+    std::string_view color = "Unpainted";   // Optional
+
+    constexpr bool operator==(const CarSpec&) const = default;
+
+    Car toCar() const {
+        return CarBuilder()
+                .setMake(std::string(make))
+                .setModel(std::string(model))
+                .setYear(year)
+                .setColor(std::string(color))
+                .build();
+    }
+};
+
+// One bit per field, "Required" must all be set before build().
+namespace CarField {
+    enum : unsigned {
+        Make = 1u << 0,
+        Model = 1u << 1,
+        Year = 1u << 2,
+        Color = 1u << 3,
+
+        Required = Make | Model | Year
+    };
+}
+
+template <unsigned Set>
+concept HasRequiredCarFields = (Set & CarField::Required) == CarField::Required;
+
+template <unsigned Set = 0>
+class TypestateCarBuilder {
+public:
+    constexpr TypestateCarBuilder() = default;
+
+    constexpr TypestateCarBuilder<Set | CarField::Make> setMake(std::string_view make) const
+        requires((Set & CarField::Make) == 0) {
+        CarSpec spec = spec_;
+        spec.make = make;
+        return TypestateCarBuilder<Set | CarField::Make>(spec);
+    }
+
+    constexpr TypestateCarBuilder<Set | CarField::Model> setModel(std::string_view model) const
+        requires((Set & CarField::Model) == 0) {
+        CarSpec spec = spec_;
+        spec.model = model;
+        return TypestateCarBuilder<Set | CarField::Model>(spec);
+    }
+
+    constexpr TypestateCarBuilder<Set | CarField::Year> setYear(int year) const
+        requires((Set & CarField::Year) == 0) {
+        CarSpec spec = spec_;
+        spec.year = year;
+        return TypestateCarBuilder<Set | CarField::Year>(spec);
+    }
+
+    constexpr TypestateCarBuilder<Set | CarField::Color> setColor(std::string_view color) const
+        requires((Set & CarField::Color) == 0) {
+        CarSpec spec = spec_;
+        spec.color = color;
+        return TypestateCarBuilder<Set | CarField::Color>(spec);
+    }
+
+    // Only declared once make, model and year were set: otherwise the error names the unsatisfied "HasRequiredCarFields<Set>".
+    constexpr CarSpec build() const requires HasRequiredCarFields<Set> {
+        return spec_;
+    }
+
+private:
+    template <unsigned> friend class TypestateCarBuilder;
+
+    constexpr explicit TypestateCarBuilder(const CarSpec& spec) : spec_(spec) {}
+
+    CarSpec spec_;
+};
+
+// The bit mask costs nothing: whatever fields are set, the builder is exactly its CarSpec.
+static_assert(sizeof(TypestateCarBuilder<>) == sizeof(CarSpec));
+static_assert(sizeof(TypestateCarBuilder<CarField::Required | CarField::Color>) == sizeof(CarSpec));
@@ -0,0 +1,103 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+
+#include <iostream>
+#include <cstdio>
+#include <string_view>
+
+#include "TypestateCarBuilder.hpp"  // Build with: g++ -std=c++20 main.cpp
+
+
+/**
+ * \brief  The Fluent Builder of "Fluent Builder Construction" happily builds a Car without a make or a year:
+ *
+ *             Car car = CarBuilder().setModel("Camry").build();   // Compiles, make_ is "" and year_ is 0
+ *
+ *         Checking it in build() at run time costs a test on every build and only fails once the program runs.
+ *         The Typestate Builder moves the check into the type system: the type of the builder records which fields are set,
+ *         so the same mistake does not compile:
+ *
+ *             TypestateCarBuilder<>().setModel("Camry").build();
+ *             // error: no matching function for call to 'TypestateCarBuilder<2>::build()'
+ *             // note: the expression '(Set & CarField::Required) == CarField::Required [with Set = 2]' evaluated to 'false'
+ *             //       (only the model, bit 2, is set: make and year are missing)
+ *
+ *             TypestateCarBuilder<>().setMake("BMW").setMake("Audi");
+ *             // error: no matching function for call to 'TypestateCarBuilder<1>::setMake(const char [5])'
+ *             // note: the expression '(Set & CarField::Make) == 0 [with Set = 1]' evaluated to 'false'   (make set twice)
+*/
+
+
+// "Does this builder have a build()?": lets us check at compile time what the compiler accepts and what it rejects.
+template <typename Builder>
+concept Buildable = requires(const Builder& builder) { builder.build(); };
+
+template <typename Builder>
+concept YearSettable = requires(const Builder& builder) { builder.setYear(2024); };
+
+using EmptyBuilder = TypestateCarBuilder<>;
+using WithoutYear = decltype(TypestateCarBuilder<>().setMake("Toyota").setModel("Camry"));
+using Complete = decltype(TypestateCarBuilder<>().setMake("Toyota").setModel("Camry").setYear(2023));
+
+static_assert(!Buildable<EmptyBuilder>);
+static_assert(!Buildable<WithoutYear>);
+static_assert(Buildable<Complete>);                       // The color is optional
+static_assert(!YearSettable<Complete>);                   // Every field can be set once only
+
+
+// A configuration made of literals is built by the compiler: no code runs for it at all.
+constexpr CarSpec camry = TypestateCarBuilder<>()
+                              .setMake("Toyota")
+                              .setModel("Camry")
+                              .setYear(2023)
+                              .setColor("Blue")
+                              .build();
+
+static_assert(camry == CarSpec{"Toyota", "Camry", 2023, "Blue"});
+static_assert(TypestateCarBuilder<>().setYear(2024).setModel("X6").setMake("BMW").build().color == "Unpainted");
+
+
+/**
+ *  \brief   Zero run-time overhead: "viaBuilder" and "viaAggregate" compile to the same code (g++ 12, -O2 on x86-64): the stores
+ *           of the four fields into the returned CarSpec and a "ret", no call, no copy of a temporary builder, nothing left of the
+ *           bit mask. The only difference is that the aggregate version stores the color view with one 16-byte move instead of
+ *           two 8-byte ones. To check it on your compiler:
+ *
+ *               g++ -std=c++20 -O2 -c main.cpp -o main.o
+ *               objdump -d --no-show-raw-insn -C main.o      # compare the bodies of viaBuilder() and viaAggregate()
+*/
+[[gnu::noinline]] CarSpec viaBuilder(std::string_view make, std::string_view model, int year, std::string_view color) {
+    return TypestateCarBuilder<>().setMake(make).setModel(model).setYear(year).setColor(color).build();
+}
+
+[[gnu::noinline]] CarSpec viaAggregate(std::string_view make, std::string_view model, int year, std::string_view color) {
+    return CarSpec{make, model, year, color};
+}
+
+
+int main(int argc, char* argv[]) {
+    // Run-time values go through the same builder, checked by the same types.
+    const std::string_view color = argc > 1 ? argv[1] : "Black";
+    Car bmw = TypestateCarBuilder<>()
+                    .setMake("BMW")
+                    .setModel("X6")
+                    .setYear(2024)
+                    .setColor(color)
+                    .build()
+                    .toCar();
+
+    camry.toCar().describe();
+    bmw.describe();
+
+    std::cout << "Builder and aggregate agree: " << std::boolalpha
+              << (viaBuilder("Audi", "A4", 2022, "Red") == viaAggregate("Audi", "A4", 2022, "Red")) << std::endl;
+
+    getchar();
+
+    return 0;
+}
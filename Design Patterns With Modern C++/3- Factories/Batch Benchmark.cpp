@@ -0,0 +1,129 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief A manifest of 1M car type names (8 types, in random order, read from a text buffer like a real manifest), turned into cars:
+ *
+ *          - one by one : CarFactory::createCar() for every entry into a std::vector<std::unique_ptr<Car>>, then car->drive() for
+ *                         each of them,
+ *          - batched    : CarFactory::createCars(manifest), then batch.drive() (one array and one devirtualized loop per type),
+ *                         and, to tell the layout from the devirtualization, batch[i]->drive() in manifest order.
+ *
+ *        Times per car (best of 3 cycles): creating, driving (10 rounds, averaged) and destroying. The benchmark's types drive by
+ *        adding to their odometer instead of logging a line.
+ *
+ *        With g++ 12 -O2 (glibc malloc, single core), ns per car:
+ *
+ *                                  create   drive   destroy
+ *            one by one             ~115     ~22      ~115
+ *            createCars()            ~70      ~7       ~14
+ *            batch[i]->drive()                ~21
+ *
+ *        Driving in manifest order through the vtable costs about as much as the scattered one-by-one cars: the gain comes from
+ *        the devirtualized loop over each type's array, not from the layout alone.
+ *
+ *        Build: g++ -std=c++20 -O2 "Batch Benchmark.cpp" -o BatchBenchmark
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+#include "CarFactory.hpp"
+
+
+// Types of different sizes, registered in the global registry like the compiled-in ones.
+template <int Id, std::size_t Payload>
+class FleetCar : public Car {
+public:
+    void drive() override { odometer += Id + 0.5; }
+
+private:
+    double odometer = 0;
+    char cargo[Payload] = {};
+};
+
+inline const CarRegistration<FleetCar<0, 8>> sedanRegistration{"Sedan"};
+inline const CarRegistration<FleetCar<1, 8>> hatchbackRegistration{"Hatchback"};
+inline const CarRegistration<FleetCar<2, 24>> wagonRegistration{"StationWagon"};
+inline const CarRegistration<FleetCar<3, 24>> coupeRegistration{"Coupe"};
+inline const CarRegistration<FleetCar<4, 40>> vanRegistration{"DeliveryVan"};
+inline const CarRegistration<FleetCar<5, 40>> pickupRegistration{"Pickup"};
+inline const CarRegistration<FleetCar<6, 56>> truckRegistration{"Truck"};
+inline const CarRegistration<FleetCar<7, 56>> busRegistration{"Bus"};
+
+template <typename Body>
+static double nanosecondsPerCar(std::size_t cars, int rounds, Body body) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) body();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (double(cars) * rounds);
+}
+
+// glibc merges the small blocks freed since the last large allocation when the next large allocation comes (a 1M-car cleanup
+// costs tens of ms there): done right away, so that each approach pays for its own destruction.
+static void settleHeap() {
+    ::operator delete(::operator new(1 << 20));
+}
+
+int main() {
+    const std::size_t count = 1000000;
+    static const char* names[] = {"Sedan", "Hatchback", "StationWagon", "Coupe", "DeliveryVan", "Pickup", "Truck", "Bus"};
+
+    // The manifest file's text, one name per line, and the entries pointing into it.
+    std::string text;
+    std::mt19937 random(7);
+    for (std::size_t i = 0; i < count; ++i) text.append(names[random() % 8]).push_back('\n');
+    std::vector<std::string_view> manifest;
+    manifest.reserve(count);
+    for (std::size_t start = 0, end; start < text.size(); start = end + 1) {
+        end = text.find('\n', start);
+        manifest.push_back(std::string_view(text).substr(start, end - start));
+    }
+
+    // Best of 3 create/drive/destroy cycles: the first one also pays for the page faults of memory the process never touched.
+    double createOne = 1e300, driveOne = 1e300, destroyOne = 1e300;
+    double createBatch = 1e300, driveBatch = 1e300, driveBatchVirtual = 1e300, destroyBatch = 1e300;
+    for (int cycle = 0; cycle < 3; ++cycle) {
+        std::vector<std::unique_ptr<Car>> cars;
+        cars.reserve(count);
+        createOne = std::min(createOne, nanosecondsPerCar(count, 1, [&] {
+            for (std::string_view name : manifest) cars.push_back(CarFactory::createCar(name));
+        }));
+        driveOne = std::min(driveOne, nanosecondsPerCar(count, 10, [&] {
+            for (const std::unique_ptr<Car>& car : cars) car->drive();
+        }));
+        destroyOne = std::min(destroyOne, nanosecondsPerCar(count, 1, [&] {
+            cars.clear();
+            settleHeap();
+        }));
+
+        CarBatch batch;
+        createBatch = std::min(createBatch, nanosecondsPerCar(count, 1, [&] { batch = CarFactory::createCars(manifest); }));
+        driveBatch = std::min(driveBatch, nanosecondsPerCar(count, 10, [&] { batch.drive(); }));
+        driveBatchVirtual = std::min(driveBatchVirtual, nanosecondsPerCar(count, 10, [&] {
+            for (std::size_t i = 0; i < batch.size(); ++i) batch[i]->drive();
+        }));
+        destroyBatch = std::min(destroyBatch, nanosecondsPerCar(count, 1, [&] {
+            batch = CarBatch();
+            settleHeap();
+        }));
+    }
+
+    std::printf("ns per car            create   drive   destroy\n");
+    std::printf("one by one           %7.1f %7.2f %9.1f\n", createOne, driveOne, destroyOne);
+    std::printf("createCars()         %7.1f %7.2f %9.1f\n", createBatch, driveBatch, destroyBatch);
+    std::printf("  batch[i]->drive()          %7.2f   (same arrays, virtual calls in manifest order)\n", driveBatchVirtual);
+
+    getchar();
+    return 0;
+}
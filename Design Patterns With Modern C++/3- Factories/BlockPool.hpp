@@ -0,0 +1,250 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief BlockPool: recycled memory for objects of one size, so creating and destroying them at a high rate does not go to the heap.
+ *
+ *        Every car type of the "CarRegistry" has one, and "PooledCarFactory" ("CarFactory.hpp") creates the cars in it.
+ *
+ *          - A destroyed object's block goes on a free list, and the next object of the same type takes it back.
+ *          - Each thread has its own cache (free list) per pool: acquire() and release() only touch the calling thread's cache,
+ *            no lock, no atomic read-modify-write.
+ *          - When a cache is empty, it refills "batch" blocks at once from the pool's shared free list (under a mutex), or from a new
+ *            slab of "slabBlocks" blocks when that one is empty too. When a cache holds more than 2 * batch blocks (a thread that
+ *            destroys what another one creates), it gives "batch" of them back.
+ *          - stats() reports how many acquires were served by the calling thread's cache ("hits"), by a refill from the shared list,
+ *            or needed a new slab. The counters are per thread, added up on read.
+ *
+ *        Slabs are only released with the pool: the pool keeps the peak. Every block must be back in the pool by then (a pooled car
+ *        is destroyed before its type is removed), so the destructor frees the slabs and empties the threads' caches of them at once.
+ *        A pool's id, the index of its cache in each thread, goes to the next pool created: a thread that used pools created and
+ *        destroyed in a loop (a plugin's types) keeps at most one cache per pool alive at once, not one per pool it ever met.
+ */
+
+#pragma once
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+
+
+class BlockPool {
+public:
+    struct Stats {
+        std::uint64_t acquires = 0;
+        std::uint64_t cacheHits = 0;      // Served by the thread's own cache
+        std::uint64_t refills = 0;        // Cache refilled from the shared free list
+        std::uint64_t slabs = 0;          // Cache refilled from a new slab
+        std::size_t blocks = 0;           // Blocks in all slabs
+
+        double hitRate() const { return acquires ? double(cacheHits) / double(acquires) : 0.0; }
+    };
+
+    BlockPool(std::size_t blockSize, std::size_t alignment, std::size_t slabBlocks = 1024, std::size_t batch = 256)
+        : shared_(std::make_shared<Shared>(blockSize, alignment, slabBlocks, batch)), id_(ids().take()) {}
+
+    ~BlockPool() {
+        shared_->close();
+        ids().give(id_);
+    }
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    void* acquire() {
+        Cache& cache = localCache();
+        cache.acquires.store(cache.acquires.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (!cache.head) shared_->refill(cache);
+        else cache.hits.store(cache.hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        FreeBlock* block = cache.head;
+        cache.head = block->next;
+        --cache.count;
+        return block;
+    }
+
+    void release(void* memory) {
+        Cache& cache = localCache();
+        cache.head = new (memory) FreeBlock{cache.head};
+        if (++cache.count > 2 * shared_->batch) shared_->drain(cache, shared_->batch);
+    }
+
+    std::size_t blockSize() const { return shared_->blockSize; }
+
+    Stats stats() const { return shared_->stats(); }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct Shared;
+
+    // One thread's free list for one pool. The counters have a single writer (the thread) and are read by stats().
+    struct Cache {
+        std::shared_ptr<Shared> shared;   // Keeps the slabs alive as long as this thread may still hand out their blocks
+        FreeBlock* head = nullptr;
+        std::size_t count = 0;
+        std::atomic<std::uint64_t> acquires{0};
+        std::atomic<std::uint64_t> hits{0};
+    };
+
+    struct Shared {
+        const std::size_t blockSize;
+        const std::size_t alignment;
+        const std::size_t slabBlocks;
+        const std::size_t batch;
+
+        std::mutex mutex;
+        FreeBlock* head = nullptr;
+        std::vector<void*> slabs;
+        std::vector<Cache*> caches;            // Of the running threads
+        Stats retired;                         // Counters of the exited threads, refills and slabs of all of them
+
+        Shared(std::size_t size, std::size_t align, std::size_t slab, std::size_t batchSize)
+            : blockSize((std::max(size, sizeof(FreeBlock)) + std::max(align, alignof(FreeBlock)) - 1) /
+                        std::max(align, alignof(FreeBlock)) * std::max(align, alignof(FreeBlock))),
+              alignment(std::max(align, alignof(FreeBlock))),
+              slabBlocks(std::max<std::size_t>(slab, 1)),
+              batch(std::max<std::size_t>(batchSize, 1)) {}
+
+        ~Shared() {
+            for (void* slab : slabs) ::operator delete(slab, std::align_val_t(alignment));
+        }
+
+        // The pool is destroyed: no block is in use, so the slabs go now. The caches stay attached (empty) until their thread
+        // reuses the id or exits, holding this Shared alone.
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (Cache* cache : caches) {
+                cache->head = nullptr;
+                cache->count = 0;
+            }
+            head = nullptr;
+            for (void* slab : slabs) ::operator delete(slab, std::align_val_t(alignment));
+            slabs.clear();
+        }
+
+        void refill(Cache& cache) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!head) {
+                char* slab = static_cast<char*>(::operator new(slabBlocks * blockSize, std::align_val_t(alignment)));
+                slabs.push_back(slab);
+                for (std::size_t i = slabBlocks; i-- > 0;) head = new (slab + i * blockSize) FreeBlock{head};
+                ++retired.slabs;
+                retired.blocks += slabBlocks;
+            } else {
+                ++retired.refills;
+            }
+            for (std::size_t i = 0; i < batch && head; ++i) {
+                FreeBlock* block = head;
+                head = block->next;
+                block->next = cache.head;
+                cache.head = block;
+                ++cache.count;
+            }
+        }
+
+        void drain(Cache& cache, std::size_t count) {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (std::size_t i = 0; i < count && cache.head; ++i) {
+                FreeBlock* block = cache.head;
+                cache.head = block->next;
+                --cache.count;
+                block->next = head;
+                head = block;
+            }
+        }
+
+        void attach(Cache& cache) {
+            std::lock_guard<std::mutex> lock(mutex);
+            caches.push_back(&cache);
+        }
+
+        // Thread exit: the blocks go back to the shared list, the counters into "retired".
+        void detach(Cache& cache) {
+            drain(cache, cache.count);
+            std::lock_guard<std::mutex> lock(mutex);
+            retired.acquires += cache.acquires.load(std::memory_order_relaxed);
+            retired.cacheHits += cache.hits.load(std::memory_order_relaxed);
+            caches.erase(std::find(caches.begin(), caches.end(), &cache));
+        }
+
+        Stats stats() {
+            std::lock_guard<std::mutex> lock(mutex);
+            Stats total = retired;
+            for (const Cache* cache : caches) {
+                total.acquires += cache->acquires.load(std::memory_order_relaxed);
+                total.cacheHits += cache->hits.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+    };
+
+    // The calling thread's caches, indexed by pool id. A cache whose "shared" is not the pool's belongs to a destroyed pool
+    // that had the same id.
+    struct ThreadCaches {
+        std::vector<std::unique_ptr<Cache>> byPool;
+
+        ~ThreadCaches() {
+            for (std::unique_ptr<Cache>& cache : byPool) {
+                if (cache) cache->shared->detach(*cache);
+            }
+        }
+    };
+
+    // The ids of the live pools, reused: the smallest free one first.
+    struct Ids {
+        std::mutex mutex;
+        std::vector<std::size_t> free;
+        std::size_t next = 0;
+
+        std::size_t take() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (free.empty()) return next++;
+            std::pop_heap(free.begin(), free.end(), std::greater<>());
+            const std::size_t id = free.back();
+            free.pop_back();
+            return id;
+        }
+
+        void give(std::size_t id) {
+            std::lock_guard<std::mutex> lock(mutex);
+            free.push_back(id);
+            std::push_heap(free.begin(), free.end(), std::greater<>());
+        }
+    };
+
+    // Never destroyed: the global registry's pools are destroyed after every static created later, this one included.
+    static Ids& ids() {
+        static Ids* instance = new Ids;
+        return *instance;
+    }
+
+    Cache& localCache() {
+        thread_local ThreadCaches caches;
+        if (id_ < caches.byPool.size() && caches.byPool[id_] && caches.byPool[id_]->shared == shared_) return *caches.byPool[id_];
+        return attachCache(caches);
+    }
+
+    Cache& attachCache(ThreadCaches& caches) {
+        if (caches.byPool.size() <= id_) caches.byPool.resize(id_ + 1);
+        if (caches.byPool[id_]) caches.byPool[id_]->shared->detach(*caches.byPool[id_]);   // Of a destroyed pool
+        caches.byPool[id_] = std::make_unique<Cache>();
+        caches.byPool[id_]->shared = shared_;
+        shared_->attach(*caches.byPool[id_]);
+        return *caches.byPool[id_];
+    }
+
+    std::shared_ptr<Shared> shared_;
+    std::size_t id_;
+};
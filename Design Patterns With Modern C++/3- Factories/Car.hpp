@@ -0,0 +1,62 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief The "Car" base class, and "CarTypeOps": what the "CarRegistry" needs to create and handle one Car subclass, as plain
+ *        function pointers built by carTypeOpsOf<T>() where the class is defined.
+ *
+ *        This is all a car plugin ("CarPluginApi.hpp") has to include: the registry, the factories and the compiled-in types stay on the
+ *        program's side, so a plugin never carries its own copy of their code (or of their statics and thread_locals).
+ */
+
+#pragma once
+
+#include <memory>
+#include <cstddef>
+
+
+// Base class
+class Car {
+public:
+    virtual void drive() = 0;
+    virtual ~Car() {}
+};
+
+// An array of "count" cars of one type, for "CarBatch": built, driven and destroyed with one indirect call for all of them.
+struct CarArrayOps {
+    std::size_t size;                                         // sizeof(the type)
+    std::size_t alignment;
+    void (*construct)(void* storage, std::size_t count);
+    void (*destroy)(void* storage, std::size_t count);
+    void (*drive)(void* storage, std::size_t count);          // Calls the type's own drive(), not through the vtable
+    Car* (*at)(void* storage, std::size_t index);
+};
+
+struct CarTypeOps {
+    std::unique_ptr<Car> (*create)();
+    Car* (*constructAt)(void* memory);    // Constructs the car in memory of array.size bytes, aligned to array.alignment
+    CarArrayOps array;
+};
+
+template <typename T>
+CarTypeOps carTypeOpsOf() {
+    return CarTypeOps{
+        [] () -> std::unique_ptr<Car> { return std::make_unique<T>(); },
+        [](void* memory) -> Car* { return new (memory) T(); },
+        CarArrayOps{
+            sizeof(T),
+            alignof(T),
+            [](void* storage, std::size_t count) { std::uninitialized_value_construct_n(static_cast<T*>(storage), count); },
+            [](void* storage, std::size_t count) { std::destroy_n(static_cast<T*>(storage), count); },
+            [](void* storage, std::size_t count) {
+                T* cars = static_cast<T*>(storage);
+                for (std::size_t i = 0; i < count; ++i) cars[i].T::drive();   // Qualified: a direct (inlinable) call
+            },
+            [](void* storage, std::size_t index) -> Car* { return static_cast<T*>(storage) + index; },
+        },
+    };
+}
@@ -0,0 +1,222 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief CarBatch: the cars of a whole manifest, created at once by "CarFactory::createCars(types)".
+ *
+ *        Creating a mixed batch one "createCar(name)" at a time looks every name up, allocates every car on its own, and leaves
+ *        the cars of one type scattered over the heap; driving them is then one virtual call (and often a cache miss) per car.
+ *        createCars() instead:
+ *
+ *          1) resolves each distinct name once (a small hash table from name to group in front of the registry, skipped when an
+ *             entry is equal to the one before it) and counts the cars of each type: the creator, storage and layout of a type
+ *             are resolved once;
+ *          2) allocates one array per type and constructs all the cars of that type in it, side by side;
+ *          3) hands back the batch, organised both ways:
+ *               - batch[i]              : the car for manifest entry i (nullptr for an unknown type, like createCar()),
+ *               - batch.groups()        : one "Group" per type, whose drive() runs the type's own drive() over its whole array,
+ *                                         one indirect call per group instead of one virtual call per car,
+ *               - batch.drive()         : every group, one after the other.
+ *
+ *        The cars live and die with the batch: no car can be taken out of it.
+ *        The types must stay registered while the batch lives (a plugin's types, "CarPlugins.hpp", are unloaded after its batches).
+ */
+
+#pragma once
+
+#include <new>
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <string_view>
+
+#include "Cars.hpp"
+
+
+class CarBatch {
+public:
+    class Group {
+    public:
+        std::string_view type() const { return type_->name; }
+        std::size_t size() const { return count_; }
+        Car& operator[](std::size_t index) const { return *type_->array.at(storage_, index); }
+
+        // The type's drive() for every car of the group, without virtual dispatch.
+        void drive() const { type_->array.drive(storage_, count_); }
+
+    private:
+        friend class CarBatch;
+
+        Group(const CarRegistry::CarType* type, std::size_t count) : type_(type), count_(count) {}
+
+        const CarRegistry::CarType* type_;
+        void* storage_ = nullptr;
+        std::size_t count_;
+    };
+
+    CarBatch() = default;
+
+    // Builds the cars of "types" (see the file comment) from the types registered in "registry".
+    explicit CarBatch(std::span<const std::string_view> types, const CarRegistry& registry = CarRegistry::global()) {
+        // One read section for the whole build: the registry cannot delete a type found here before its cars are constructed.
+        Rcu::ReadGuard guard;
+
+        // 1) Group index of every entry (NoGroup when the type is unknown), cars per group.
+        NameCache groupOfName;                                                // Every distinct name met so far, known or not
+        std::vector<std::uint32_t> groupOfType(registry.idLimit(), NoGroup);   // Aliases ("Sedan", "sedan") share a group
+        std::vector<std::uint32_t> groupOfEntry(types.size());
+        std::vector<std::size_t> counts;   // Kept in locals: the loop's stores cannot alias the registry's tables
+        std::size_t unknown = 0;
+        std::string_view previousName;
+        std::uint32_t previousGroup = NoGroup;
+        for (std::size_t i = 0; i < types.size(); ++i) {
+            if (i == 0 || types[i] != previousName) {
+                previousName = types[i];
+                auto [cached, added] = groupOfName.find(types[i]);
+                if (added) {
+                    if (const CarRegistry::CarType* type = registry.find(types[i], guard)) {
+                        if (type->id >= groupOfType.size()) groupOfType.resize(type->id + 1, NoGroup);   // Added since idLimit()
+                        std::uint32_t& group = groupOfType[type->id];
+                        if (group == NoGroup) {
+                            group = static_cast<std::uint32_t>(groups_.size());
+                            groups_.push_back(Group(type, 0));
+                            counts.push_back(0);
+                        }
+                        *cached = group;
+                    }
+                }
+                previousGroup = *cached;
+            }
+            groupOfEntry[i] = previousGroup;
+            if (previousGroup != NoGroup) ++counts[previousGroup];
+            else ++unknown;
+        }
+        for (std::size_t g = 0; g < groups_.size(); ++g) groups_[g].count_ = counts[g];
+        unknown_ = unknown;
+
+        // 2) One array per group. If an allocation or a constructor throws, release() destroys the groups built so far
+        //    (no destructor runs for an object whose constructor throws).
+        for (Group& group : groups_) {
+            const CarRegistry::ArrayOps& array = group.type_->array;
+            void* storage = nullptr;
+            try {
+                storage = ::operator new(array.size * group.count_, std::align_val_t(array.alignment));
+                array.construct(storage, group.count_);
+            } catch (...) {
+                if (storage) ::operator delete(storage, std::align_val_t(array.alignment));
+                release();
+                throw;
+            }
+            group.storage_ = storage;
+        }
+
+        // 3) Manifest order. Within an array, the cars are "size" bytes apart: no call per entry to find them.
+        std::vector<char*> next(groups_.size());
+        for (std::size_t g = 0; g < groups_.size(); ++g) next[g] = reinterpret_cast<char*>(&groups_[g][0]);
+        cars_.resize(types.size());
+        for (std::size_t i = 0; i < types.size(); ++i) {
+            if (const std::uint32_t group = groupOfEntry[i]; group != NoGroup) {
+                cars_[i] = reinterpret_cast<Car*>(next[group]);
+                next[group] += groups_[group].type_->array.size;
+            }
+        }
+    }
+
+    CarBatch(CarBatch&& other) noexcept
+        : groups_(std::move(other.groups_)), cars_(std::move(other.cars_)), unknown_(std::exchange(other.unknown_, 0)) {
+        other.groups_.clear();
+    }
+
+    CarBatch& operator=(CarBatch&& other) noexcept {
+        if (this != &other) {
+            release();
+            groups_ = std::move(other.groups_);
+            cars_ = std::move(other.cars_);
+            unknown_ = std::exchange(other.unknown_, 0);
+            other.groups_.clear();
+        }
+        return *this;
+    }
+
+    ~CarBatch() { release(); }
+
+    std::size_t size() const { return cars_.size(); }
+    Car* operator[](std::size_t entry) const { return cars_[entry]; }
+    std::size_t unknown() const { return unknown_; }   // Entries whose type is not registered
+    std::span<const Group> groups() const { return groups_; }
+
+    void drive() const {
+        for (const Group& group : groups_) group.drive();
+    }
+
+private:
+    static constexpr std::uint32_t NoGroup = UINT32_MAX;
+
+    // Group of every distinct name of a manifest: an open-addressing table on the registry's own name hash, so a hit costs
+    // about what the registry's lookup would, without going through the registry's tables and the type's id again.
+    class NameCache {
+    public:
+        // The group of "name" (NoGroup in it if new), and whether it was just added.
+        std::pair<std::uint32_t*, bool> find(std::string_view name) {
+            const std::uint64_t hash = CarRegistry::hashOf(name);
+            for (std::size_t i = hash & mask_;; i = (i + 1) & mask_) {
+                Entry& entry = entries_[i];
+                if (entry.group == Free) {
+                    if (2 * (used_ + 1) > entries_.size()) {   // Kept at most half full: probes stay short
+                        grow();
+                        return find(name);
+                    }
+                    entry = Entry{hash, name, NoGroup};
+                    ++used_;
+                    return {&entry.group, true};
+                }
+                if (entry.hash == hash && entry.name == name) return {&entry.group, false};
+            }
+        }
+
+    private:
+        static constexpr std::uint32_t Free = NoGroup - 1;
+
+        struct Entry {
+            std::uint64_t hash = 0;
+            std::string_view name;
+            std::uint32_t group = Free;
+        };
+
+        void grow() {
+            std::vector<Entry> old(entries_.size() * 2);
+            old.swap(entries_);
+            mask_ = entries_.size() - 1;
+            for (const Entry& entry : old) {
+                if (entry.group == Free) continue;
+                std::size_t i = entry.hash & mask_;
+                while (entries_[i].group != Free) i = (i + 1) & mask_;
+                entries_[i] = entry;
+            }
+        }
+
+        std::vector<Entry> entries_ = std::vector<Entry>(32);
+        std::size_t mask_ = 31;
+        std::size_t used_ = 0;
+    };
+
+    void release() {
+        for (Group& group : groups_) {
+            if (!group.storage_) continue;
+            const CarRegistry::ArrayOps& array = group.type_->array;
+            array.destroy(group.storage_, group.count_);
+            ::operator delete(group.storage_, std::align_val_t(array.alignment));
+        }
+        groups_.clear();
+        cars_.clear();
+    }
+
+    std::vector<Group> groups_;
+    std::vector<Car*> cars_;
+    std::size_t unknown_ = 0;
+};
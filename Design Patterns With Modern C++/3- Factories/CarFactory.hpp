@@ -0,0 +1,125 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief The Factory class from "main.cpp": it knows no car type by itself anymore, it asks the "CarRegistry" the types
+ *        registered themselves in ("Cars.hpp").
+ *
+ *        "PooledCarFactory" is the same factory for cars created and destroyed at a high rate: each car is constructed in a block
+ *        of its type's "BlockPool", and its "PoolDeleter" gives the block back to the pool instead of freeing it.
+ *
+ *            PooledCar car = PooledCarFactory::createCar("RaceCar");   // std::unique_ptr<Car, PoolDeleter>
+ *            car->drive();
+ *            car.reset();                                              // ~RaceCar(), then the block is recycled
+ *
+ *        A pooled car must be destroyed before the registry (the end of the program), like any object using a static allocator, and
+ *        before its type is removed (a plugin's, "CarPlugins.hpp").
+ *
+ *        "InstrumentedCarFactory" is the same factory again, counting what it does per type ("CarTelemetry.hpp"): created, destroyed
+ *        and alive cars, their bytes, their construction time, and the names it did not know. Its cars too are destroyed before
+ *        their type is removed.
+ *
+ *        The lookups never take a lock, even while plugins are being loaded or unloaded ("CarRegistry.hpp").
+ *
+ *        "CarFactory::createCars(types)" creates a whole manifest at once, grouped by type ("CarBatch.hpp").
+ */
+
+#pragma once
+
+#include <span>
+#include <memory>
+#include <string_view>
+
+#include "Cars.hpp"
+#include "CarBatch.hpp"
+#include "CarTelemetry.hpp"
+
+
+// Factory class
+class CarFactory {
+public:
+    // nullptr for a type nobody registered (CarRegistry::create() throws instead, with the name in the message).
+    static std::unique_ptr<Car> createCar(std::string_view carType) {
+        return CarRegistry::global().withType(carType, [](const CarRegistry::CarType* type) {
+            return type ? type->create() : std::unique_ptr<Car>();
+        });
+    }
+
+    // A whole manifest at once: one array per type, cars of a type driven together (see "CarBatch.hpp").
+    static CarBatch createCars(std::span<const std::string_view> carTypes) {
+        return CarBatch(carTypes);
+    }
+};
+
+// Destroys the car and hands its block back to the pool it came from.
+struct PoolDeleter {
+    BlockPool* pool = nullptr;
+
+    void operator()(Car* car) const {
+        void* block = dynamic_cast<void*>(car);   // The start of the most derived object, where the block starts
+        car->~Car();
+        pool->release(block);
+    }
+};
+
+using PooledCar = std::unique_ptr<Car, PoolDeleter>;
+
+class PooledCarFactory {
+public:
+    // Empty for a type nobody registered.
+    static PooledCar createCar(std::string_view carType) {
+        return CarRegistry::global().withType(carType, [](const CarRegistry::CarType* type) {
+            if (!type) return PooledCar();
+
+            void* block = type->pool->acquire();
+            try {
+                return PooledCar(type->constructAt(block), PoolDeleter{type->pool.get()});
+            } catch (...) {
+                type->pool->release(block);
+                throw;
+            }
+        });
+    }
+
+    // Hit rate and refills of one type's pool (all zeros for an unknown type).
+    static BlockPool::Stats stats(std::string_view carType) {
+        return CarRegistry::global().withType(carType, [](const CarRegistry::CarType* type) {
+            return type ? type->pool->stats() : BlockPool::Stats{};
+        });
+    }
+};
+
+// Records every car it creates and destroys in "CarTelemetry": the same cars as CarFactory's, with a deleter that counts the
+// destruction (so the handle is a different type).
+struct TelemetryDeleter {
+    std::uint32_t typeId = 0;
+    std::uint64_t typeSerial = 0;
+
+    void operator()(Car* car) const {
+        delete car;
+        CarTelemetry::destroyed(typeId, typeSerial);
+    }
+};
+
+using InstrumentedCar = std::unique_ptr<Car, TelemetryDeleter>;
+
+class InstrumentedCarFactory {
+public:
+    // Empty for a type nobody registered, counted in CarTelemetry::Snapshot::unknown.
+    static InstrumentedCar createCar(std::string_view carType) {
+        return CarRegistry::global().withType(carType, [](const CarRegistry::CarType* type) {
+            if (!type) {
+                CarTelemetry::unknown();
+                return InstrumentedCar();
+            }
+            const CarTelemetry::Construction construction = CarTelemetry::constructing(*type);
+            InstrumentedCar car(type->create().release(), TelemetryDeleter{type->id, type->serial});
+            CarTelemetry::created(*type, construction);
+            return car;
+        });
+    }
+};
@@ -0,0 +1,54 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief What a car plugin (a shared library loaded at run time by "CarPlugins.hpp") implements: one exported function that
+ *        registers its types.
+ *
+ *            #include "CarPluginApi.hpp"
+ *
+ *            class ElectricCar : public Car { ... };
+ *
+ *            CAR_PLUGIN_EXPORT void registerCarPlugin(CarPluginRegistrar& registrar) {
+ *                registrar.add<ElectricCar>("ElectricCar");
+ *            }
+ *
+ *        add<T>() only builds T's "CarTypeOps" (function pointers into the plugin) and hands them to the program through a virtual
+ *        call: the registry itself is the program's, never instantiated inside the plugin.
+ *
+ *        Build (Linux): g++ -std=c++20 -O2 -shared -fPIC ElectricCars.cpp -o ElectricCars.so
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "Car.hpp"
+
+
+#ifdef _WIN32
+#define CAR_PLUGIN_EXPORT extern "C" __declspec(dllexport)
+#else
+#define CAR_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+// The name "CarPlugins.hpp" looks up in the library.
+inline constexpr const char* CarPluginEntryPoint = "registerCarPlugin";
+
+class CarPluginRegistrar {
+public:
+    // Registers T (a Car subclass of the plugin) under "name". Throws std::invalid_argument if the name is already taken.
+    template <typename T>
+    void add(std::string_view name) { addType(name, carTypeOpsOf<T>()); }
+
+protected:
+    ~CarPluginRegistrar() = default;
+
+    virtual void addType(std::string_view name, const CarTypeOps& ops) = 0;
+};
+
+using RegisterCarPlugin = void (*)(CarPluginRegistrar& registrar);
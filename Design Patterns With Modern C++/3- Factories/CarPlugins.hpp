@@ -0,0 +1,120 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief CarPlugin: car types loaded from a shared library at run time (dlopen / LoadLibrary), while other threads keep creating
+ *        cars.
+ *
+ *            auto plugin = std::make_unique<CarPlugin>("./ElectricCars.so");   // Its types are in CarRegistry::global() now
+ *            std::unique_ptr<Car> car = CarFactory::createCar("ElectricCar");
+ *            car->drive();
+ *            car.reset();
+ *            plugin.reset();                                                     // Types removed, then the library unloaded
+ *
+ *        Loading calls the library's "registerCarPlugin" ("CarPluginApi.hpp"); unloading removes every type it registered, then
+ *        closes the library. Neither one stops the creators: a lookup that started before a type was removed finishes with the old
+ *        registry snapshot, and the remove only returns once it has (see "CarRegistry.hpp").
+ *
+ *        The library's code must outlive its cars, which the registry cannot know about: every car of a plugin type (pooled cars
+ *        and "CarBatch"es included) must be destroyed before the plugin. A car that is created and destroyed within one
+ *        "Rcu::ReadGuard" can never outlive it: the unload waits for that read section to end.
+ *
+ *        Load errors throw std::runtime_error with the loader's message; if "registerCarPlugin" throws (a name already taken),
+ *        the types it did add are removed and the library closed before the exception goes on.
+ *
+ *        Build (Linux): link with -ldl (glibc older than 2.34).
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include "CarPluginApi.hpp"
+#include "CarRegistry.hpp"
+
+
+class CarPlugin {
+public:
+    explicit CarPlugin(const std::string& path, CarRegistry& registry = CarRegistry::global()) : registry_(registry) {
+        library_ = open(path);
+        try {
+            auto entry = reinterpret_cast<RegisterCarPlugin>(symbol(library_, CarPluginEntryPoint));
+            if (!entry) throw std::runtime_error("CarPlugin: \"" + path + "\" has no " + CarPluginEntryPoint + "()");
+            Registrar registrar(*this);
+            entry(registrar);
+        } catch (...) {
+            unload();
+            throw;
+        }
+    }
+
+    ~CarPlugin() { unload(); }
+
+    CarPlugin(const CarPlugin&) = delete;
+    CarPlugin& operator=(const CarPlugin&) = delete;
+
+    // The names this plugin registered.
+    const std::vector<std::string>& types() const { return types_; }
+
+private:
+    class Registrar final : public CarPluginRegistrar {
+    public:
+        explicit Registrar(CarPlugin& plugin) : plugin_(plugin) {}
+
+    private:
+        void addType(std::string_view name, const CarTypeOps& ops) override {
+            plugin_.registry_.add(name, ops);
+            plugin_.types_.emplace_back(name);
+        }
+
+        CarPlugin& plugin_;
+    };
+
+#ifdef _WIN32
+    using Library = HMODULE;
+
+    static Library open(const std::string& path) {
+        Library library = LoadLibraryA(path.c_str());
+        if (!library) throw std::runtime_error("CarPlugin: cannot load \"" + path + "\" (error " + std::to_string(GetLastError()) + ")");
+        return library;
+    }
+
+    static void* symbol(Library library, const char* name) { return reinterpret_cast<void*>(GetProcAddress(library, name)); }
+    static void close(Library library) { FreeLibrary(library); }
+#else
+    using Library = void*;
+
+    static Library open(const std::string& path) {
+        Library library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!library) throw std::runtime_error(std::string("CarPlugin: ") + dlerror());
+        return library;
+    }
+
+    static void* symbol(Library library, const char* name) { return dlsym(library, name); }
+    static void close(Library library) { dlclose(library); }
+#endif
+
+    // Each remove() returns once no lookup can still be using the type: nothing runs the library's code after that but the
+    // cars the caller was told to destroy first.
+    void unload() {
+        for (const std::string& type : types_) registry_.remove(type);
+        types_.clear();
+        close(library_);
+    }
+
+    CarRegistry& registry_;
+    Library library_;
+    std::vector<std::string> types_;
+};
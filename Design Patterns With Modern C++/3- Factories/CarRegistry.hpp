@@ -0,0 +1,284 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief CarRegistry: the car types a factory can create, looked up by name through a perfect hash.
+ *
+ *        The first "CarFactory::createCar" compared the requested name with every type it knew, one "if" after the other, and every
+ *        new type meant editing the factory. Here each "Car" subclass registers itself, next to its own definition:
+ *
+ *            inline const CarRegistration<RaceCar> raceCarRegistration{"RaceCar"};
+ *
+ *        and the factory asks the registry, which finds the type with one hash of the name, two table reads and one comparison,
+ *        however many types there are:
+ *
+ *          - Every add() rebuilds a minimal-collision perfect hash of all the names ("hash and displace"): the names are spread over
+ *            buckets, and each bucket gets the seed that sends all of its names to empty slots of the table. A lookup hashes the
+ *            name once, reads its bucket's seed, and checks the one name that can be in the slot it lands on.
+ *          - Unknown names are answered cleanly: withType() passes nullptr, create() throws std::invalid_argument naming the type.
+ *          - Each type also carries what "PooledCarFactory" needs to create it in recycled memory (its "BlockPool" and a
+ *            placement constructor), and what "CarBatch" needs to handle arrays of it ("ArrayOps").
+ *
+ *        Types can be added and removed at any time (plugins, "CarPlugins.hpp"), and lookups never wait for that: the types and
+ *        their perfect hash are an immutable "Snapshot", a change builds and publishes a new one (writers take a mutex), and the old
+ *        one is deleted once "Rcu" (read-copy-update) has seen every lookup that could still use it finish. A lookup is a read
+ *        section: two stores to the thread's own counter and a fence, no lock, no atomic read-modify-write.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <mutex>
+#include <atomic>
+
+#include "Car.hpp"
+#include "BlockPool.hpp"
+#include "../Utilities/Rcu.hpp"
+
+
+class CarRegistry {
+public:
+    using Creator = std::unique_ptr<Car> (*)();
+    using ArrayOps = CarArrayOps;
+
+    struct CarType {
+        std::string name;
+        Creator create;
+        Car* (*constructAt)(void* memory);    // Constructs the car in a block of "pool"
+        std::unique_ptr<BlockPool> pool;      // Recycled blocks of sizeof(the type), see "PooledCarFactory"
+        ArrayOps array;
+        std::uint64_t hash;
+        std::uint32_t id = 0;                 // Below idLimit(), unique among the registered types, reused once the type is removed
+        std::uint64_t serial = 0;             // Never reused: tells the type from an earlier one that had the same id
+    };
+
+    // The registry the "CarRegistration"s of the compiled-in types fill in.
+    static CarRegistry& global() {
+        static CarRegistry registry;
+        return registry;
+    }
+
+    CarRegistry() : current_(new Snapshot({})) {}
+    ~CarRegistry() { delete current_.load(std::memory_order_relaxed); }
+
+    CarRegistry(const CarRegistry&) = delete;
+    CarRegistry& operator=(const CarRegistry&) = delete;
+
+    // Registers T (a Car subclass) under "name", throws std::invalid_argument when the name is already taken.
+    template <typename T>
+    void add(std::string_view name) { add(name, carTypeOpsOf<T>()); }
+
+    // The same for a type known only by its operations (a plugin's, "CarPlugins.hpp").
+    void add(std::string_view name, const CarTypeOps& ops) {
+        auto type = std::make_shared<CarType>(CarType{std::string(name),
+                                                      ops.create,
+                                                      ops.constructAt,
+                                                      std::make_unique<BlockPool>(ops.array.size, ops.array.alignment),
+                                                      ops.array,
+                                                      hashOf(name)});
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        const Snapshot& old = *current_.load(std::memory_order_relaxed);
+        if (old.find(name)) throw std::invalid_argument("CarRegistry: \"" + std::string(name) + "\" is already registered");
+        if (freeIds_.empty()) {
+            type->id = nextId_.load(std::memory_order_relaxed);
+            nextId_.store(type->id + 1, std::memory_order_relaxed);
+        } else {
+            type->id = freeIds_.back();
+            freeIds_.pop_back();
+        }
+        type->serial = ++lastSerial_;
+        std::vector<std::shared_ptr<const CarType>> types = old.types;
+        types.push_back(std::move(type));
+        publish(new Snapshot(std::move(types)));
+    }
+
+    // Unregisters "name" (false if it was not registered). When it returns, no lookup can find the type anymore, and none is
+    // still using it inside a read section; its cars that already exist are the caller's business. Its id goes to the next type
+    // added, so that the tables indexed by id ("CarBatch", "CarTelemetry", the pools' caches) stay as large as the registry.
+    bool remove(std::string_view name) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        const Snapshot& old = *current_.load(std::memory_order_relaxed);
+        const CarType* type = old.find(name);
+        if (!type) return false;
+        std::vector<std::shared_ptr<const CarType>> types;
+        types.reserve(old.types.size() - 1);
+        for (const std::shared_ptr<const CarType>& t : old.types) {
+            if (t.get() != type) types.push_back(t);
+        }
+        const std::uint32_t id = type->id;
+        publish(new Snapshot(std::move(types)));
+        freeIds_.push_back(id);
+        return true;
+    }
+
+    // Calls "use(type)" (nullptr for an unknown name) inside a read section: "type" stays valid during the call even if another
+    // thread removes it at the same time. Never takes a lock.
+    template <typename Use>
+    decltype(auto) withType(std::string_view name, Use&& use) const {
+        Rcu::ReadGuard guard;
+        return use(current_.load(std::memory_order_acquire)->find(name));
+    }
+
+    // The same for a caller that holds its own read section (a lookup per entry of a batch): the type stays valid until "guard"
+    // ends, not after.
+    const CarType* find(std::string_view name, const Rcu::ReadGuard& guard) const {
+        static_cast<void>(guard);
+        return current_.load(std::memory_order_acquire)->find(name);
+    }
+
+    bool contains(std::string_view name) const {
+        return withType(name, [](const CarType* type) { return type != nullptr; });
+    }
+
+    std::unique_ptr<Car> create(std::string_view name) const {
+        return withType(name, [name](const CarType* type) {
+            if (!type) throw std::invalid_argument("CarRegistry: unknown car type \"" + std::string(name) + "\"");
+            return type->create();
+        });
+    }
+
+    std::size_t size() const {
+        Rcu::ReadGuard guard;
+        return current_.load(std::memory_order_acquire)->types.size();
+    }
+
+    // One past the largest id handed out: at most the most types ever registered at once.
+    std::uint32_t idLimit() const { return nextId_.load(std::memory_order_relaxed); }
+
+    // 8 bytes of the name per multiplication (car names are one or two words), then the splitmix64 finalizer so that the low
+    // bits (the bucket) depend on every byte. The last word overlaps the one before it rather than being copied byte by byte.
+    static std::uint64_t hashOf(std::string_view name) {
+        std::uint64_t hash = name.size() * 0x9e3779b97f4a7c15ull;
+        const char* p = name.data();
+        const char* const end = p + name.size();
+        for (; end - p > 8; p += 8) hash = step(hash, load<std::uint64_t>(p));
+        if (name.size() >= 8) {
+            hash = step(hash, load<std::uint64_t>(end - 8));
+        } else if (name.size() >= 4) {
+            hash = step(hash, load<std::uint32_t>(p) | std::uint64_t(load<std::uint32_t>(end - 4)) << 32);
+        } else if (!name.empty()) {
+            const auto byte = [](char c) { return std::uint64_t(static_cast<unsigned char>(c)); };
+            hash = step(hash, byte(p[0]) | byte(p[name.size() / 2]) << 8 | byte(end[-1]) << 16);
+        }
+        return mix(hash);
+    }
+
+private:
+    static constexpr std::uint32_t Empty = UINT32_MAX;
+
+    // One immutable version of the registry: the types and their perfect hash. Replaced as a whole by add() and remove().
+    struct Snapshot {
+        std::vector<std::shared_ptr<const CarType>> types;
+        std::vector<std::uint32_t> seeds;   // One per bucket
+        std::vector<std::uint32_t> slots;   // Index into types, or Empty
+        std::size_t mask = 0;
+
+        explicit Snapshot(std::vector<std::shared_ptr<const CarType>> all) : types(std::move(all)) {
+            // A power of two at least as large as the number of types: the slot is a mask, not a division. Doubled in the
+            // (rare) case where a bucket finds no seed.
+            std::size_t size = 1;
+            while (size < types.size()) size <<= 1;
+            while (!tryBuild(size)) size <<= 1;
+        }
+
+        const CarType* find(std::string_view name) const {
+            if (types.empty()) return nullptr;
+            const std::uint64_t hash = hashOf(name);
+            const std::uint32_t index = slots[slotOf(hash, seeds[hash & mask])];
+            if (index == Empty) return nullptr;
+            const CarType& type = *types[index];
+            return type.hash == hash && type.name == name ? &type : nullptr;
+        }
+
+        // "Hash and displace": the seed moves each name of the bucket by a different step (odd, so every slot is reachable).
+        std::size_t slotOf(std::uint64_t hash, std::uint32_t seed) const {
+            return static_cast<std::size_t>(((hash >> 32) + seed * ((hash >> 8) | 1)) & mask);
+        }
+
+        bool tryBuild(std::size_t size) {
+            constexpr std::uint32_t MaxSeeds = 1 << 16;
+            mask = size - 1;
+
+            std::vector<std::vector<std::uint32_t>> buckets(size);
+            for (std::uint32_t i = 0; i < types.size(); ++i) buckets[types[i]->hash & mask].push_back(i);
+
+            // The biggest buckets first, while most slots are still free.
+            std::vector<std::uint32_t> order(size);
+            for (std::uint32_t b = 0; b < size; ++b) order[b] = b;
+            std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+            seeds.assign(size, 0);
+            slots.assign(size, Empty);
+            std::vector<std::size_t> placed;
+            for (std::uint32_t b : order) {
+                if (buckets[b].empty()) break;
+                std::uint32_t seed = 0;
+                for (; seed < MaxSeeds; ++seed) {
+                    placed.clear();
+                    for (std::uint32_t i : buckets[b]) {
+                        const std::size_t slot = slotOf(types[i]->hash, seed);
+                        if (slots[slot] != Empty || std::find(placed.begin(), placed.end(), slot) != placed.end()) break;
+                        placed.push_back(slot);
+                    }
+                    if (placed.size() == buckets[b].size()) break;
+                }
+                if (seed == MaxSeeds) return false;
+                for (std::size_t k = 0; k < placed.size(); ++k) slots[placed[k]] = buckets[b][k];
+                seeds[b] = seed;
+            }
+            return true;
+        }
+    };
+
+    template <typename Word>
+    static Word load(const char* p) {
+        Word word;
+        std::memcpy(&word, p, sizeof(Word));
+        return word;
+    }
+
+    static std::uint64_t step(std::uint64_t hash, std::uint64_t word) {
+        hash = (hash ^ word) * 0xff51afd7ed558ccdull;
+        return hash ^ (hash >> 32);
+    }
+
+    static std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    // Called with writeMutex_ held: the old snapshot is deleted once no reader can be looking at it.
+    void publish(const Snapshot* next) {
+        const Snapshot* old = current_.exchange(next, std::memory_order_acq_rel);
+        Rcu::synchronize();
+        delete old;
+    }
+
+    std::atomic<const Snapshot*> current_;
+    std::mutex writeMutex_;
+    std::atomic<std::uint32_t> nextId_{0};      // Written under writeMutex_, read by idLimit()
+    std::vector<std::uint32_t> freeIds_;        // Of the removed types, under writeMutex_
+    std::uint64_t lastSerial_ = 0;
+};
+
+// A namespace-scope "inline const CarRegistration<T> x{"Name"};" registers T in the global registry before main() runs.
+template <typename T>
+struct CarRegistration {
+    explicit CarRegistration(std::string_view name) {
+        CarRegistry::global().add<T>(name);
+    }
+};
@@ -0,0 +1,274 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief CarTelemetry: what the factory has been doing, per car type, for "InstrumentedCarFactory" ("CarFactory.hpp").
+ *
+ *          - cars created and destroyed, and so the cars alive right now,
+ *          - bytes allocated for them (sizeof the type per car), in total and alive,
+ *          - a histogram of the construction time (allocation and constructor, "LatencyHistogram"),
+ *          - how many names were not a registered type (createCar() returned nullptr).
+ *
+ *            CarTelemetry::Snapshot now = CarTelemetry::snapshot();
+ *            for (const CarTelemetry::TypeStats& type : now.types) logLine(type.text());
+ *
+ *        Recording never touches another thread's memory: each thread has its own counters per type, and snapshot() adds them up
+ *        (with the counters of the threads that have exited). The counts are single-writer atomics (a load and a store, no
+ *        read-modify-write); the histogram is only fed one construction in sampleEvery() (16 by default, per thread and type),
+ *        under a mutex of the thread's own that only snapshot() ever contends for: two clock reads on every car would cost more
+ *        than the rest of the telemetry.
+ *
+ *        The figures are kept by type name: a plugin's type keeps them after the plugin is unloaded, and adds to them when it is
+ *        loaded again. A thread's counters are indexed by registry id, which the registry reuses, so a thread that meets the types
+ *        of a plugin loaded and unloaded in a loop holds one set of counters per id, not one per type it ever met: the counters of a
+ *        removed type are handed over the first time the thread records a car of the type that took its id. As for the pooled
+ *        cars, an instrumented car must be destroyed before its type is removed. The plain "CarFactory" records nothing: a
+ *        program that does not use InstrumentedCarFactory does not pay for any of this.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <string_view>
+
+#include "CarRegistry.hpp"
+#include "../Utilities/LatencyHistogram.hpp"
+
+
+class CarTelemetry {
+public:
+    struct TypeStats {
+        std::string name;
+        std::size_t size = 0;                 // sizeof the type, bytes allocated per car
+        std::uint64_t created = 0;
+        std::uint64_t destroyed = 0;
+        LatencyHistogram constructionNs;      // The sampled constructions
+
+        // Destroyed counts can run ahead of created ones between the threads' reads; the gauges never go negative.
+        std::uint64_t alive() const { return created > destroyed ? created - destroyed : 0; }
+        std::uint64_t bytesAllocated() const { return created * size; }
+        std::uint64_t bytesAlive() const { return alive() * size; }
+
+        std::string text() const {
+            return name + ": created=" + std::to_string(created) + " destroyed=" + std::to_string(destroyed) +
+                   " alive=" + std::to_string(alive()) + " bytes=" + std::to_string(bytesAllocated()) +
+                   " aliveBytes=" + std::to_string(bytesAlive()) + " constructionNs{" + constructionNs.text() + "}";
+        }
+    };
+
+    struct Snapshot {
+        std::vector<TypeStats> types;         // One per name, in the order of their first car
+        std::uint64_t unknown = 0;            // Names that were not a registered type
+
+        const TypeStats* find(std::string_view name) const {
+            auto it = std::find_if(types.begin(), types.end(), [name](const TypeStats& type) { return type.name == name; });
+            return it == types.end() ? nullptr : &*it;
+        }
+    };
+
+    // What a creation needs to carry to created(): the start time, if this one is sampled.
+    struct Construction {
+        std::chrono::steady_clock::time_point start;
+        bool sampled = false;
+    };
+
+    // Call right before constructing a car of "type", then created() right after.
+    static Construction constructing(const CarRegistry::CarType& type) {
+        TypeCounters& counters = localCounters(type);
+        if (--counters.countdown != 0) return Construction{};
+        const std::uint32_t period = samplePeriod().load(std::memory_order_relaxed);
+        counters.countdown = period ? period : NotSampled;
+        if (!period) return Construction{};
+        return Construction{std::chrono::steady_clock::now(), true};
+    }
+
+    static void created(const CarRegistry::CarType& type, const Construction& construction) {
+        TypeCounters& counters = localCounters(type);
+        bump(counters.created);
+        if (construction.sampled) {
+            const auto elapsed = std::chrono::steady_clock::now() - construction.start;
+            std::lock_guard<std::mutex> lock(counters.histogramMutex);
+            counters.constructionNs.record(elapsed);
+        }
+    }
+
+    // CarRegistry::CarType's id and serial, taken when the car was created: the destruction does not look the type up.
+    static void destroyed(std::uint32_t typeId, std::uint64_t serial) {
+        ThreadCounters& thread = localThread();
+        TypeCounters* counters = typeId < thread.byType.size() ? thread.byType[typeId].get() : nullptr;
+        if (!counters || counters->serial != serial) counters = &thread.attach(typeId, serial, nullptr);
+        bump(counters->destroyed);
+    }
+
+    static void unknown() { bump(localThread().unknown->created); }
+
+    // Feed the construction histogram with one car in "period" (per thread and type), 1 for every car, 0 for none.
+    static void sampleEvery(std::uint32_t period) { samplePeriod().store(period, std::memory_order_relaxed); }
+
+    static Snapshot snapshot() { return shared().snapshot(); }
+
+private:
+    static constexpr std::uint32_t NotSampled = 1u << 20;   // Countdown while sampling is off: the period is read again after it
+    static constexpr std::uint32_t UnknownId = UINT32_MAX;
+    static constexpr std::size_t NoFigure = SIZE_MAX;
+
+    // One thread's figures for one type. The counts have a single writer (the thread) and are read by snapshot().
+    struct TypeCounters {
+        std::uint32_t typeId;
+        std::uint64_t serial;
+        std::size_t figure = NoFigure;        // Index in Shared::figures, set by Shared::attach()
+        std::atomic<std::uint64_t> created{0};
+        std::atomic<std::uint64_t> destroyed{0};
+        std::uint32_t countdown = 1;          // Constructions until the next sampled one
+        std::mutex histogramMutex;
+        LatencyHistogram constructionNs;
+
+        TypeCounters(std::uint32_t id, std::uint64_t typeSerial) : typeId(id), serial(typeSerial) {}
+    };
+
+    struct Shared;
+
+    // The calling thread's counters, indexed by type id. The "unknown" counter is a TypeCounters of its own, not in byType.
+    struct ThreadCounters {
+        std::vector<std::unique_ptr<TypeCounters>> byType;
+        std::unique_ptr<TypeCounters> unknown;
+
+        ThreadCounters();
+        ~ThreadCounters();
+
+        TypeCounters& attach(std::uint32_t typeId, std::uint64_t serial, const CarRegistry::CarType* type);
+    };
+
+    // The type that has an id now, as far as the telemetry has seen.
+    struct TypeInfo {
+        std::uint64_t serial = 0;
+        std::size_t figure = NoFigure;
+    };
+
+    struct Shared {
+        std::mutex mutex;
+        std::vector<TypeInfo> types;              // By type id
+        std::vector<TypeStats> figures;           // By name, in the order of their first car: counts of the detached counters
+        std::vector<TypeCounters*> counters;      // Attached to a running thread
+        std::uint64_t retiredUnknown = 0;
+
+        // A creation ("type" given) names the figure of its type; a destruction only finds it, the type being gone by then.
+        void attach(TypeCounters& counters, const CarRegistry::CarType* type) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (counters.typeId != UnknownId) {
+                if (types.size() <= counters.typeId) types.resize(counters.typeId + 1);
+                TypeInfo& info = types[counters.typeId];
+                if (type && info.serial != counters.serial) info = TypeInfo{counters.serial, figureOf(type->name, type->array.size)};
+                if (info.serial == counters.serial) counters.figure = info.figure;
+            }
+            this->counters.push_back(&counters);
+        }
+
+        // Thread exit, or counters of a removed type: the counts move into "figures".
+        void detach(TypeCounters& counters) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (counters.figure != NoFigure) add(figures[counters.figure], counters);
+            this->counters.erase(std::find(this->counters.begin(), this->counters.end(), &counters));
+        }
+
+        void detachUnknown(TypeCounters& counters) {
+            std::lock_guard<std::mutex> lock(mutex);
+            retiredUnknown += counters.created.load(std::memory_order_relaxed);
+            this->counters.erase(std::find(this->counters.begin(), this->counters.end(), &counters));
+        }
+
+        Snapshot snapshot() {
+            std::lock_guard<std::mutex> lock(mutex);
+            Snapshot result;
+            result.types = figures;
+            result.unknown = retiredUnknown;
+            for (TypeCounters* counters : this->counters) {
+                if (counters->typeId == UnknownId) result.unknown += counters->created.load(std::memory_order_relaxed);
+                else if (counters->figure != NoFigure) add(result.types[counters->figure], *counters);
+            }
+            return result;
+        }
+
+        // Called with the mutex held.
+        std::size_t figureOf(std::string_view name, std::size_t size) {
+            auto it = std::find_if(figures.begin(), figures.end(), [name](const TypeStats& figure) { return figure.name == name; });
+            if (it != figures.end()) {
+                it->size = size;   // A type registered again under the name: its size from now on
+                return static_cast<std::size_t>(it - figures.begin());
+            }
+            figures.emplace_back();
+            figures.back().name = std::string(name);
+            figures.back().size = size;
+            return figures.size() - 1;
+        }
+
+        static void add(TypeStats& total, TypeCounters& counters) {
+            total.created += counters.created.load(std::memory_order_relaxed);
+            total.destroyed += counters.destroyed.load(std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(counters.histogramMutex);
+            total.constructionNs.merge(counters.constructionNs);
+        }
+    };
+
+
+    // The only writer of the counter: no atomic read-modify-write needed.
+    static void bump(std::atomic<std::uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    static Shared& shared() {
+        static Shared instance;
+        return instance;
+    }
+
+    static std::atomic<std::uint32_t>& samplePeriod() {
+        static std::atomic<std::uint32_t> period{16};
+        return period;
+    }
+
+    static ThreadCounters& localThread() {
+        thread_local ThreadCounters thread;
+        return thread;
+    }
+
+    static TypeCounters& localCounters(const CarRegistry::CarType& type) {
+        ThreadCounters& thread = localThread();
+        if (type.id < thread.byType.size() && thread.byType[type.id] && thread.byType[type.id]->serial == type.serial) {
+            return *thread.byType[type.id];
+        }
+        return thread.attach(type.id, type.serial, &type);
+    }
+};
+
+inline CarTelemetry::ThreadCounters::ThreadCounters() : unknown(std::make_unique<TypeCounters>(UnknownId, 0)) {
+    shared().attach(*unknown, nullptr);
+}
+
+inline CarTelemetry::ThreadCounters::~ThreadCounters() {
+    for (std::unique_ptr<TypeCounters>& counters : byType) {
+        if (counters) shared().detach(*counters);
+    }
+    shared().detachUnknown(*unknown);
+}
+
+// The first car of a type this thread creates or destroys. "type" is nullptr for a destruction: the name is then recorded by
+// whichever thread created the car. Counters left at "typeId" by a removed type are handed over first.
+inline CarTelemetry::TypeCounters& CarTelemetry::ThreadCounters::attach(std::uint32_t typeId, std::uint64_t serial,
+                                                                        const CarRegistry::CarType* type) {
+    if (byType.size() <= typeId) byType.resize(typeId + 1);
+    if (byType[typeId]) shared().detach(*byType[typeId]);
+    byType[typeId] = std::make_unique<TypeCounters>(typeId, serial);
+    shared().attach(*byType[typeId], type);
+    return *byType[typeId];
+}
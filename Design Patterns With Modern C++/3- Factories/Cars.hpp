@@ -0,0 +1,44 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief The compiled-in derived classes of "Car" ("Car.hpp") from "main.cpp", each one registering itself in the
+ *        "CarRegistry" under its own name: adding a car type means adding a class and its registration here, not editing the factory.
+ */
+
+#pragma once
+
+#include "Car.hpp"
+#include "CarRegistry.hpp"
+#include "../Utilities/LogSink.hpp"  // Buffered replacement for "std::cout << ... << std::endl"
+
+
+// Derived classes
+class RaceCar : public Car {
+public:
+    void drive() override {
+        logLine("Driving a race car!");
+    }
+};
+
+class OffRoadCar : public Car {
+public:
+    void drive() override {
+        logLine("Driving an off-road car!");
+    }
+};
+
+class TownCar : public Car {
+public:
+    void drive() override {
+        logLine("Driving a town car!");
+    }
+};
+
+inline const CarRegistration<RaceCar> raceCarRegistration{"RaceCar"};
+inline const CarRegistration<OffRoadCar> offRoadCarRegistration{"OffRoadCar"};
+inline const CarRegistration<TownCar> townCarRegistration{"TownCar"};
@@ -0,0 +1,159 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Creators against a plugin loader: 3 threads create, drive and destroy cars of 4 types (2 of "QuietCars.hpp", 2 from
+ *        "Plugins/ElectricCars.cpp") as fast as they can, half of them pooled, while a 4th thread loads and unloads the plugin in a loop.
+ *
+ *        Each creator keeps its car inside an "Rcu::ReadGuard", so no car of the plugin can outlive an unload. A plugin type is
+ *        either found (and its car works) or not found; every wrong outcome aborts: a compiled-in type missing, a crash in the
+ *        plugin's code after dlclose, a registry snapshot deleted under a lookup, type ids not reused. Run it under
+ *        -fsanitize=thread or -fsanitize=address as well.
+ *
+ *        Prints the creators' lookups per second (found or not), the latency of one createCar() (lookup and construction, measured on
+ *        one call in 64, clock reads included), and how many load/unload cycles ran.
+ *
+ *        With g++ 12 -O2, on a single core:
+ *
+ *                             M createCar/s   p50 / p99 ns    plugin cycles
+ *            without loader       20-22         72 / 111-123         -
+ *            with loader          18-19         76 / 122-125       14-19 /s
+ *
+ *        The lookups take no lock: a load or an unload copies the registry, publishes the copy and waits, on its own thread, for the
+ *        lookups still reading the old one. The worst cases (ms) are the creators waiting for the core, with or without the loader.
+ *        The loader is what waits: on one core, a creator preempted inside its read section holds an unload until it runs again,
+ *        hence the few cycles per second.
+ *
+ *        Build (from this folder):
+ *            g++ -std=c++20 -O2 -shared -fPIC Plugins/ElectricCars.cpp -o ElectricCars.so
+ *            g++ -std=c++20 -O2 "Plugin Stress Test.cpp" -o PluginStressTest -pthread -ldl
+ *            ./PluginStressTest ./ElectricCars.so
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+#include "CarFactory.hpp"
+#include "QuietCars.hpp"
+#include "CarPlugins.hpp"
+#include "../Utilities/LatencyHistogram.hpp"
+
+
+static const std::string_view types[] = {"Sedan", "Coupe", "ElectricCar", "SolarCar"};
+
+struct CreatorResult {
+    std::uint64_t cars = 0;         // Created, driven and destroyed
+    std::uint64_t notFound = 0;     // Plugin type looked up while the plugin was unloaded
+    LatencyHistogram createNs;
+};
+
+static void creator(unsigned seed, const std::atomic<bool>& stop, CreatorResult& result) {
+    std::mt19937 random(seed);
+    while (!stop.load(std::memory_order_relaxed)) {
+        for (int i = 0; i < 1024; ++i) {
+            const std::size_t which = random() % 4;
+            const bool timed = i % 64 == 0;   // Reading the clock costs about as much as creating a car
+            Rcu::ReadGuard guard;             // The car never outlives the plugin it comes from
+            const auto start = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+            if (which % 2) {
+                PooledCar car = PooledCarFactory::createCar(types[which]);
+                if (timed) result.createNs.record(std::chrono::steady_clock::now() - start);
+                if (!car) {
+                    if (which < 2) std::abort();
+                    ++result.notFound;
+                    continue;
+                }
+                car->drive();
+            } else {
+                std::unique_ptr<Car> car = CarFactory::createCar(types[which]);
+                if (timed) result.createNs.record(std::chrono::steady_clock::now() - start);
+                if (!car) {
+                    if (which < 2) std::abort();
+                    ++result.notFound;
+                    continue;
+                }
+                car->drive();
+            }
+            ++result.cars;
+        }
+    }
+}
+
+// Runs the creators for "seconds", with the loader if "plugin" is not empty.
+static void run(const char* name, const std::string& plugin, double seconds) {
+    const unsigned creators = 3;
+    std::atomic<bool> stop{false};
+    std::vector<CreatorResult> results(creators);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < creators; ++t) threads.emplace_back(creator, 7 + t, std::cref(stop), std::ref(results[t]));
+
+    std::uint64_t cycles = 0;
+    std::thread loader;
+    if (!plugin.empty()) {
+        loader = std::thread([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                CarPlugin loaded(plugin);
+                std::this_thread::yield();   // Leaves the types in for a while
+                ++cycles;
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    for (std::thread& thread : threads) thread.join();
+    if (loader.joinable()) loader.join();
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    CreatorResult total;
+    for (const CreatorResult& result : results) {
+        total.cars += result.cars;
+        total.notFound += result.notFound;
+        total.createNs.merge(result.createNs);
+    }
+    std::printf("%-16s %6.2f M createCar/s  p50 %4llu ns  p99 %5llu ns  max %8llu ns", name, (total.cars + total.notFound) / elapsed / 1e6,
+                static_cast<unsigned long long>(total.createNs.percentile(50)), static_cast<unsigned long long>(total.createNs.percentile(99)),
+                static_cast<unsigned long long>(total.createNs.max()));
+    if (!plugin.empty()) {
+        std::printf("  %llu plugin cycles (%.0f/s), %.1f%% plugin lookups missed", static_cast<unsigned long long>(cycles), cycles / elapsed,
+                    100.0 * total.notFound / (total.cars / 2 + total.notFound));
+    }
+    std::printf("\n");
+}
+
+int main(int argc, char** argv) {
+    const std::string plugin = argc > 1 ? argv[1] : "./ElectricCars.so";
+
+    {
+        // The plugin's types work like the compiled-in ones while it is loaded, and are gone after.
+        CarPlugin loaded(plugin);
+        std::cout << "Loaded " << plugin << ":";
+        for (const std::string& type : loaded.types()) std::cout << " " << type;
+        std::cout << std::endl;
+        CarFactory::createCar("ElectricCar")->drive();
+    }
+    if (CarFactory::createCar("ElectricCar")) std::abort();
+
+    run("without loader", "", 2.0);
+    run("with loader", plugin, 2.0);
+
+    // Every cycle gave its ids back: what is indexed by id (the threads' pool caches among others) did not grow with the cycles.
+    if (CarRegistry::global().idLimit() > CarRegistry::global().size() + 2) std::abort();
+
+    getchar();
+    return 0;
+}
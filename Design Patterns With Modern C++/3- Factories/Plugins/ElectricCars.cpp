@@ -0,0 +1,41 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief A car plugin: two car types the program knows nothing about until it loads this library ("CarPlugins.hpp").
+ *
+ *        Build (Linux): g++ -std=c++20 -O2 -shared -fPIC ElectricCars.cpp -o ElectricCars.so
+ */
+
+
+#include "../CarPluginApi.hpp"
+
+
+class ElectricCar : public Car {
+public:
+    void drive() override {
+        charge = charge > 0 ? charge - 1 : 100;   // Recharged when empty
+    }
+
+private:
+    int charge = 100;
+};
+
+class SolarCar : public Car {
+public:
+    void drive() override {
+        distance += 0.5;
+    }
+
+private:
+    double distance = 0;
+};
+
+CAR_PLUGIN_EXPORT void registerCarPlugin(CarPluginRegistrar& registrar) {
+    registrar.add<ElectricCar>("ElectricCar");
+    registrar.add<SolarCar>("SolarCar");
+}
@@ -0,0 +1,166 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Create/destroy throughput of "CarFactory::createCar" (std::make_unique, one heap allocation per car) and
+ *        "PooledCarFactory::createCar" (blocks recycled by each type's "BlockPool"), with the 3 compiled-in types picked at random:
+ *
+ *          1) churn       : each car is destroyed right after it is created,
+ *          2) batches     : 4096 cars are alive at once, then all destroyed,
+ *          3) two threads : one thread creates batches of cars, the other one destroys them (the pool's blocks move from the
+ *                           creating thread's cache to the destroying thread's, and back through the shared free list).
+ *
+ *        Prints cars per second, heap allocations per car and the pools' cache hit rate over each run.
+ *
+ *        With g++ 12 -O2 (glibc malloc, single core), M cars/s:
+ *
+ *                             make_unique   PooledCarFactory   pool hit rate
+ *            1) churn            20-26            27-31            1.0000
+ *            2) batches          14-15            17-18            0.9971
+ *            3) two threads       10              15-16            0.9961
+ *
+ *        Both include the name lookup (~20 ns of each car here). glibc's own per-thread cache already makes a lone malloc/free pair
+ *        cheap; the pool wins most where the memory crosses threads, and it never calls the heap once its slabs are there.
+ *
+ *        Build: g++ -std=c++20 -O2 "Pool Benchmark.cpp" -o PoolBenchmark -pthread
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "CarFactory.hpp"
+#include "../Utilities/AllocationCounter.hpp"
+
+
+static const std::string_view types[] = {"RaceCar", "OffRoadCar", "TownCar"};
+
+static BlockPool::Stats poolTotals() {
+    BlockPool::Stats total;
+    for (std::string_view type : types) {
+        const BlockPool::Stats stats = PooledCarFactory::stats(type);
+        total.acquires += stats.acquires;
+        total.cacheHits += stats.cacheHits;
+        total.refills += stats.refills;
+        total.slabs += stats.slabs;
+        total.blocks += stats.blocks;
+    }
+    return total;
+}
+
+// "body" creates and destroys "cars" cars.
+template <typename Body>
+static void measure(const char* name, std::size_t cars, Body body) {
+    const std::size_t allocations0 = AllocationCounter::allocations();
+    const BlockPool::Stats pools0 = poolTotals();
+    auto start = std::chrono::steady_clock::now();
+    body();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const BlockPool::Stats pools = poolTotals();
+
+    std::printf("  %-26s %6.1f M cars/s  %5.2f allocations/car", name, cars / seconds / 1e6, double(AllocationCounter::allocations() - allocations0) / cars);
+    if (pools.acquires != pools0.acquires) {
+        std::printf("  hit rate %.4f (%llu refills, %llu slabs)", double(pools.cacheHits - pools0.cacheHits) / double(pools.acquires - pools0.acquires),
+                    static_cast<unsigned long long>(pools.refills - pools0.refills), static_cast<unsigned long long>(pools.slabs - pools0.slabs));
+    }
+    std::printf("\n");
+}
+
+template <typename Create>
+static void churn(const std::vector<std::string_view>& names, Create create) {
+    for (std::string_view name : names) {
+        auto car = create(name);
+        if (!car) std::abort();
+    }
+}
+
+template <typename Create>
+static void batches(const std::vector<std::string_view>& names, Create create) {
+    using Handle = decltype(create(names[0]));
+    std::vector<Handle> alive;
+    alive.reserve(4096);
+    for (std::string_view name : names) {
+        alive.push_back(create(name));
+        if (alive.size() == 4096) alive.clear();
+    }
+}
+
+// The creating thread hands full batches to the destroying thread through a single slot.
+template <typename Create>
+static void twoThreads(const std::vector<std::string_view>& names, Create create) {
+    using Handle = decltype(create(names[0]));
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Handle> slot;
+    bool full = false, done = false;
+
+    std::thread destroyer([&] {
+        std::vector<Handle> batch;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&] { return full || done; });
+                if (!full) return;
+                batch.swap(slot);
+                full = false;
+            }
+            cv.notify_one();
+            batch.clear();   // The cars are destroyed here, on this thread
+        }
+    });
+
+    std::vector<Handle> batch;
+    batch.reserve(4096);
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        batch.push_back(create(names[i]));
+        if (batch.size() == 4096 || i + 1 == names.size()) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return !full; });
+            slot.swap(batch);
+            full = true;
+            cv.notify_one();
+        }
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return !full; });
+        done = true;
+    }
+    cv.notify_one();
+    destroyer.join();
+}
+
+int main() {
+    const std::size_t count = 10000000;
+    std::mt19937 random(7);
+    std::vector<std::string_view> names(count);
+    for (std::string_view& name : names) name = types[random() % 3];
+
+    auto heap = [](std::string_view name) { return CarFactory::createCar(name); };
+    auto pooled = [](std::string_view name) { return PooledCarFactory::createCar(name); };
+
+    std::cout << "1) churn:" << std::endl;
+    measure("make_unique", count, [&] { churn(names, heap); });
+    measure("PooledCarFactory", count, [&] { churn(names, pooled); });
+    std::cout << "2) batches of 4096:" << std::endl;
+    measure("make_unique", count, [&] { batches(names, heap); });
+    measure("PooledCarFactory", count, [&] { batches(names, pooled); });
+    std::cout << "3) create on one thread, destroy on another:" << std::endl;
+    measure("make_unique", count, [&] { twoThreads(names, heap); });
+    measure("PooledCarFactory", count, [&] { twoThreads(names, pooled); });
+
+    getchar();
+    return 0;
+}
@@ -0,0 +1,31 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Compiled-in car types for the benchmarks and stress tests: they drive without logging (RaceCar and the other types of
+ *        "Cars.hpp" print a line per car), and register themselves as "Sedan", "Coupe", "DeliveryVan" and "Truck".
+ */
+
+#pragma once
+
+#include "Car.hpp"
+#include "CarRegistry.hpp"
+
+
+template <int Id>
+class QuietCar : public Car {
+public:
+    void drive() override { odometer += Id + 0.5; }
+
+private:
+    double odometer = 0;
+};
+
+inline const CarRegistration<QuietCar<0>> sedanRegistration{"Sedan"};
+inline const CarRegistration<QuietCar<1>> coupeRegistration{"Coupe"};
+inline const CarRegistration<QuietCar<2>> vanRegistration{"DeliveryVan"};
+inline const CarRegistration<QuietCar<3>> truckRegistration{"Truck"};
@@ -0,0 +1,112 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief What "CarTelemetry" costs: 10M cars of 4 types (picked at random, one name in 16 unknown) created, driven and destroyed
+ *        at once, on 1 thread then on 2 threads, with
+ *
+ *          - CarFactory                        : no telemetry at all,
+ *          - InstrumentedCarFactory, sample 0  : the counters only,
+ *          - InstrumentedCarFactory, sample 16 : counters, and the construction time of one car in 16 (the default),
+ *          - InstrumentedCarFactory, sample 1  : counters, and the construction time of every car.
+ *
+ *        ns per name, best of 3, then the telemetry of one type, checked against what the benchmark did.
+ *
+ *        With g++ 12 -O2 (glibc malloc, single core, where a steady_clock read costs ~35 ns), ns per name, over 3 runs:
+ *
+ *                                  1 thread    2 threads
+ *            CarFactory             55-65        61-63
+ *            sample 0               57-68        58-68
+ *            sample 16              66-77        55-79
+ *            sample 1              130-170      137-160
+ *
+ *        The counters are within the noise (a thread_local lookup and a plain store per creation and per destruction), the default
+ *        sampling adds ~10 ns; timing every car more than doubles the cost, most of it the two clock reads.
+ *
+ *        Build: g++ -std=c++20 -O2 "Telemetry Benchmark.cpp" -o TelemetryBenchmark -pthread
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+#include "CarFactory.hpp"
+#include "QuietCars.hpp"
+
+
+template <typename Create>
+static void churn(const std::vector<std::string_view>& names, Create create) {
+    for (std::string_view name : names) {
+        auto car = create(name);
+        if (car) car->drive();
+    }
+}
+
+// Best of 3, ns per name; "threads" threads each run the whole list.
+template <typename Create>
+static double measure(const std::vector<std::string_view>& names, unsigned threads, Create create) {
+    double best = 1e300;
+    for (int round = 0; round < 3; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threads; ++t) workers.emplace_back([&] { churn(names, create); });
+        churn(names, create);
+        for (std::thread& worker : workers) worker.join();
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, ns / (double(names.size()) * threads));
+    }
+    return best;
+}
+
+int main() {
+    const std::size_t count = 10000000;
+    static const std::string_view types[] = {"Sedan", "Coupe", "DeliveryVan", "Truck"};
+    std::mt19937 random(7);
+    std::vector<std::string_view> names(count);
+    std::size_t sedans = 0, unknown = 0;
+    for (std::string_view& name : names) {
+        if (random() % 16 == 0) {
+            name = "Boat";
+            ++unknown;
+        } else {
+            name = types[random() % 4];
+            sedans += name == "Sedan";
+        }
+    }
+
+    auto plain = [](std::string_view name) { return CarFactory::createCar(name); };
+    auto instrumented = [](std::string_view name) { return InstrumentedCarFactory::createCar(name); };
+
+    std::printf("ns per name               1 thread   2 threads\n");
+    std::printf("CarFactory                %8.1f   %9.1f\n", measure(names, 1, plain), measure(names, 2, plain));
+    for (std::uint32_t period : {0u, 16u, 1u}) {
+        CarTelemetry::sampleEvery(period);
+        std::printf("Instrumented, sample %-4u %8.1f", period, measure(names, 1, instrumented));
+        std::printf("   %9.1f\n", measure(names, 2, instrumented));
+    }
+
+    // 3 periods x 3 rounds x (1 + 2 threads) runs of the list.
+    const std::uint64_t runs = 3 * 3 * 3;
+    const CarTelemetry::Snapshot telemetry = CarTelemetry::snapshot();
+    const CarTelemetry::TypeStats* sedan = telemetry.find("Sedan");
+    if (!sedan || sedan->created != runs * sedans || sedan->destroyed != sedan->created || telemetry.unknown != runs * unknown) {
+        std::cout << "Telemetry does not match the benchmark!" << std::endl;
+        return 1;
+    }
+    std::cout << sedan->text() << std::endl;
+    std::cout << "unknown=" << telemetry.unknown << std::endl;
+
+    getchar();
+    return 0;
+}
@@ -26,51 +26,25 @@
 #include <memory>
 #include <fstream>
 
-
-// Base class
-class Car {
-public:
-    virtual void drive() = 0;
-    virtual ~Car() {}
-};
-
-// Derived classes
-class RaceCar : public Car {
-public:
-    void drive() override {
-        std::cout << "Driving a race car!" << std::endl;
-    }
-};
-
-class OffRoadCar : public Car {
-public:
-    void drive() override {
-        std::cout << "Driving an off-road car!" << std::endl;
-    }
-};
-
-class TownCar : public Car {
-public:
-    void drive() override {
-        std::cout << "Driving a town car!" << std::endl;
-    }
-};
-
-// Factory class
-class CarFactory {
-public:
-    static std::unique_ptr<Car> createCar(const std::string& carType) {
-        if (carType == "RaceCar") {
-            return std::make_unique<RaceCar>();
-        } else if (carType == "OffRoadCar") {
-            return std::make_unique<OffRoadCar>();
-        } else if (carType == "TownCar") {
-            return std::make_unique<TownCar>();
-        } else {
-            return nullptr;  // Invalid car type
-        } 
-    }
-};
+#include "CarFactory.hpp"  // Build with: g++ -std=c++20 main.cpp
+
+
+// The base class "Car", its derived classes and the factory live in headers, so the benchmarks of this folder can use them too:
+//
+//   - Car.hpp         : Car (the General-Usage Base class), all a plugin needs to include.
+//   - Cars.hpp        : RaceCar, OffRoadCar, TownCar, each registering itself by name.
+//   - CarRegistry.hpp : The registry of car types, a perfect hash from the name to the type's creator, read without locks.
+//   - CarPlugins.hpp  : CarPlugin, car types loaded from a shared library at run time ("Plugins/ElectricCars.cpp").
+//   - CarFactory.hpp  : CarFactory::createCar(name), which asks the registry instead of comparing the name with every known type.
+//                       PooledCarFactory::createCar(name), the same in recycled memory ("BlockPool.hpp").
+//                       CarFactory::createCars(names), a whole manifest at once, the cars of each type side by side ("CarBatch.hpp").
+//                       InstrumentedCarFactory::createCar(name), counted per type ("CarTelemetry.hpp").
+//
+// "Registry Benchmark.cpp" compares the registry with the old if/else chain for 3, 50 and 500 types.
+// "Pool Benchmark.cpp" compares the pooled factory with std::make_unique.
+// "Batch Benchmark.cpp" compares createCars() with one createCar() per entry of a 1M-car manifest.
+// "Telemetry Benchmark.cpp" measures what the telemetry costs.
+// "Plugin Stress Test.cpp" creates cars on 3 threads while a 4th one loads and unloads a plugin.
 
 int main() {
     std::unique_ptr<Car> myRaceCar = CarFactory::createCar("RaceCar");
@@ -81,6 +55,9 @@ int main() {
     myOffRoadCar->drive();   // Output: Driving an off-road car!
     myTownCar->drive();      // Output: Driving a town car!
 
+    // An unknown type is not an error of the factory's, it just has nothing to create:
+    if (!CarFactory::createCar("FlyingCar")) logLine("No car type named \"FlyingCar\" is registered");
+
     Car* rawPtr1 = myRaceCar.release();
     Car* rawPtr2 = myOffRoadCar.release();
     Car* rawPtr3 = myTownCar.release();
@@ -89,6 +66,32 @@ int main() {
     delete rawPtr2;
     delete rawPtr3;
 
+    // Pooled mode, for cars created and destroyed at a high rate: destroying one recycles its memory for the next car of its type.
+    for (int i = 0; i < 3; ++i) {
+        PooledCar pooled = PooledCarFactory::createCar("TownCar");
+        pooled->drive();
+    }   // Each "pooled" goes back to the TownCar pool here, the next iteration takes the same block again
+    logLine("TownCar pool hit rate: ", PooledCarFactory::stats("TownCar").hitRate());
+
+    // A manifest: each distinct name is looked up once, the cars of a type are built in one array and driven together.
+    const std::string_view manifest[] = {"TownCar", "TownCar", "RaceCar", "TownCar", "Boat"};
+    CarBatch fleet = CarFactory::createCars(manifest);
+    for (const CarBatch::Group& group : fleet.groups()) {
+        logLine(group.size(), " x ", group.type(), ":");
+        group.drive();
+    }
+    logLine(fleet.unknown(), " unknown type(s) in the manifest");
+
+    // Instrumented mode: the factory counts what it creates and destroys, per type.
+    {
+        InstrumentedCar tracked = InstrumentedCarFactory::createCar("OffRoadCar");
+        tracked->drive();
+        InstrumentedCarFactory::createCar("Hovercraft");   // Counted as unknown
+    }
+    const CarTelemetry::Snapshot telemetry = CarTelemetry::snapshot();
+    for (const CarTelemetry::TypeStats& type : telemetry.types) logLine(type.name, ": ", type.created, " created, ", type.alive(), " alive");
+    logLine(telemetry.unknown, " unknown type(s) asked for");
+
     getchar();
     return 0;
 }
@@ -0,0 +1,156 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Update throughput of a singleton's counters, 40M updates (Add_1 and Add_2 in turn) shared by 1, 2, 4 and 8 threads:
+ *
+ *          - mutex          : a singleton whose elem1/elem2 are plain ints behind one std::mutex,
+ *          - shared atomic  : elem1/elem2 are std::atomic<int>, updated with fetch_add (side by side, one cache line),
+ *          - sharded        : "ShardedSingleTon", each thread adds to its own slot, Get combines them.
+ *
+ *        Each run checks that Value_1() + Value_2() is the number of updates, then reads the sharded total 1M times to show what the
+ *        combine-on-read costs in exchange.
+ *
+ *        With g++ 12 -O2, M updates/s (this machine has a single core, where the threads take turns: the mutex and the shared atomic
+ *        lose even more on several cores, where every update also moves the cache line):
+ *
+ *                              1 thread   2 threads   4 threads   8 threads
+ *            mutex                37-39       37-39       37-38       37-38
+ *            shared atomic       102-108     105-110     104-107     105-107
+ *            sharded             170-188     180-186     183-184     182-193
+ *
+ *        A sharded update is a thread_local lookup, a load and a store. A sharded Get walks one slot per thread that ever updated the
+ *        value: ~23 ns here for the 8 slots left by the runs above.
+ *
+ *        Build: g++ -std=c++20 -O2 "Sharded Singleton Benchmark.cpp" -o ShardedSingletonBenchmark -pthread
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <limits>
+
+#include "ShardedSingleton.hpp"
+
+
+class LockedSingleTon {
+public:
+    static LockedSingleTon& instance() {
+        static LockedSingleTon single;
+        return single;
+    }
+
+    void Add_1(int delta) {
+        std::lock_guard<std::mutex> lock(mutex);
+        elem1 += delta;
+    }
+
+    void Add_2(int delta) {
+        std::lock_guard<std::mutex> lock(mutex);
+        elem2 += delta;
+    }
+
+    int Value_1() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return elem1;
+    }
+
+    int Value_2() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return elem2;
+    }
+
+private:
+    LockedSingleTon() = default;
+
+    std::mutex mutex;
+    int elem1 = 0;
+    int elem2 = 0;
+};
+
+class AtomicSingleTon {
+public:
+    static AtomicSingleTon& instance() {
+        static AtomicSingleTon single;
+        return single;
+    }
+
+    void Add_1(int delta) { elem1.fetch_add(delta, std::memory_order_relaxed); }
+    void Add_2(int delta) { elem2.fetch_add(delta, std::memory_order_relaxed); }
+    int Value_1() { return elem1.load(std::memory_order_relaxed); }
+    int Value_2() { return elem2.load(std::memory_order_relaxed); }
+
+private:
+    AtomicSingleTon() = default;
+
+    std::atomic<int> elem1{0};
+    std::atomic<int> elem2{0};
+};
+
+// M updates per second of "updates" updates shared by "threads" threads.
+template <typename Singleton>
+static double updatesPerSecond(unsigned threads, int updates) {
+    const int before = Singleton::instance().Value_1() + Singleton::instance().Value_2();
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            Singleton& single = Singleton::instance();
+            for (int i = 0; i < updates / int(threads); i += 2) {
+                single.Add_1(1);
+                single.Add_2(1);
+            }
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::thread& worker : workers) worker.join();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const int after = Singleton::instance().Value_1() + Singleton::instance().Value_2();
+    if (after - before != updates / int(threads) * int(threads)) {
+        std::cout << "Lost updates!" << std::endl;
+        std::exit(1);
+    }
+    return updates / seconds / 1e6;
+}
+
+int main() {
+    const int updates = 40000000;
+
+    std::printf("M updates/s           1 thread  2 threads  4 threads  8 threads\n");
+    auto row = [&](const char* name, auto run) {
+        std::printf("%-20s", name);
+        for (unsigned threads : {1u, 2u, 4u, 8u}) std::printf(" %10.1f", run(threads));
+        std::printf("\n");
+    };
+    row("mutex", [&](unsigned threads) { return updatesPerSecond<LockedSingleTon>(threads, updates); });
+    row("shared atomic", [&](unsigned threads) { return updatesPerSecond<AtomicSingleTon>(threads, updates); });
+    row("sharded", [&](unsigned threads) { return updatesPerSecond<ShardedSingleTon>(threads, updates); });
+
+    // What the sharded version pays instead: a Get walks every slot.
+    const int reads = 1000000;
+    int total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < reads; ++i) total = ShardedSingleTon::instance().Value_1();
+    std::printf("sharded Value_1(): %.1f ns per read (elem1 = %d)\n",
+                std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / reads, total);
+
+    // A different merge: the largest share instead of the sum.
+    ShardedSingleTon::instance().SetMerge_1(&ShardedValue<int>::max, std::numeric_limits<int>::lowest());
+    ShardedSingleTon::instance().Get_1();
+
+    getchar();
+    return 0;
+}
@@ -0,0 +1,72 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief ShardedSingleTon: the SingleTon of "Singleton.hpp" for elements that many threads update at a high rate.
+ *
+ *        SingleTon's elem1 and elem2 are two ints side by side, on one cache line: threads setting them write to the same line
+ *        (with atomics, the line moves from core to core on every write; behind a mutex, the threads also queue for the lock).
+ *        Here each element is a "ShardedValue": every thread writes its own cache-line-sized slot, and Get combines the slots
+ *        when it reads them, with a merge function that can be changed:
+ *
+ *          - Add_1(delta) / Add_2(delta) : adds to the calling thread's share (a counter: no lock, no atomic read-modify-write),
+ *          - Get_1() / Get_2()           : prints the merge of all the threads' shares (Value_1() / Value_2() return it),
+ *          - SetMerge_1 / SetMerge_2     : how the shares are merged, and the merge's identity: the sum and 0 by default
+ *                                          (ShardedValue<int>::max and INT_MIN, min and INT_MAX, or any int (*)(int, int)).
+ *
+ *        There is no Set_1 / Set_2: an element is the merge of every thread's share, so replacing one thread's share does not
+ *        set the element (under the sum, Set_1(5) on a thread and Set_1(7) on another would read back as 12). An element that is
+ *        set rather than added to belongs in SingleTon.
+ *
+ *            ShardedSingleTon::instance().Add_1(1);                    // On every thread, as often as needed
+ *            ShardedSingleTon::instance().Get_1();                     // elem1 = the total
+ *
+ *        Writes are cheap, reads walk one slot per thread: for state that is updated far more often than it is read.
+ */
+
+#pragma once
+
+#include <iostream>
+
+#include "../Utilities/ShardedValue.hpp"
+
+
+class ShardedSingleTon {
+public:
+    using Merge = ShardedValue<int>::Merge;
+
+    static ShardedSingleTon& instance() {
+        static ShardedSingleTon single;
+        return single;
+    }
+
+    ShardedSingleTon(const ShardedSingleTon&) = delete;
+    ShardedSingleTon& operator=(const ShardedSingleTon&) = delete;
+
+    void Add_1(int delta) { elem1.add(delta); }
+    void Add_2(int delta) { elem2.add(delta); }
+
+    int Value_1() const { return elem1.get(); }
+    int Value_2() const { return elem2.get(); }
+
+    void Get_1() const {
+        std::cout << "elem1 = " << Value_1() << std::endl;
+    }
+
+    void Get_2() const {
+        std::cout << "elem2 = " << Value_2() << std::endl;
+    }
+
+    void SetMerge_1(Merge merge, int identity) { elem1.setMerge(merge, identity); }
+    void SetMerge_2(Merge merge, int identity) { elem2.setMerge(merge, identity); }
+
+private:
+    ShardedSingleTon() = default;
+
+    ShardedValue<int> elem1;
+    ShardedValue<int> elem2;
+};
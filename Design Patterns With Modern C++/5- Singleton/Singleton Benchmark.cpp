@@ -0,0 +1,205 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief What a thread-safe lazy singleton costs, three ways of writing one:
+ *
+ *          - function-local static : "static T single; return single;" (SingleTon::instance() in "Singleton.hpp"),
+ *          - double-checked atomic : an std::atomic<T*> loaded with acquire, the mutex only taken while it is still null,
+ *          - mutex on every access : the obvious version.
+ *
+ *        1) Access: 1, 2, 4 and 8 threads sharing 20M calls of instance() once it exists, ns per call.
+ *        2) First touch: 64 fresh singletons, each one first asked for by 8 threads released at the same moment, with a constructor
+ *           that takes ~100 us (and yields, so the other threads really do arrive while it runs). Checks that each one was
+ *           constructed exactly once and that every thread got the same object, and reports how long the last thread waited.
+ *
+ *        With g++ 12 -O2, on a single core (the threads take turns, so this shows the cost of each call, not cache-line contention):
+ *
+ *                                     1 thread   8 threads   first touch (8 threads)
+ *            SingleTon::instance()        0.9-1.1     1.0-1.2              -
+ *            function-local static        0.8         0.8          220-230 us, 1 construction
+ *            double-checked atomic        0.8-0.9     0.8-0.9      230-250 us, 1 construction
+ *            mutex on every access        24-26       26-27        230-250 us, 1 construction
+ *
+ *        Once the singleton exists, the two lazy versions are a load and a predictable branch (x86 loads are already acquire), the
+ *        mutex is two atomic read-modify-writes per access, and a cache line every core writes to on a multi-core machine. The
+ *        first touch costs the same everywhere: whoever comes first constructs, the others wait for it.
+ *
+ *        Build: g++ -std=c++20 -O2 "Singleton Benchmark.cpp" -o SingletonBenchmark -pthread
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <utility>
+#include <algorithm>
+
+#include "Singleton.hpp"
+
+
+// A service with a little state, for the three ways of holding it.
+struct Service {
+    std::atomic<int> value{0};
+};
+
+template <typename T>
+struct FunctionLocalStatic {
+    static T& instance() {
+        static T single;
+        return single;
+    }
+};
+
+template <typename T>
+struct DoubleChecked {
+    static T& instance() {
+        T* single = pointer.load(std::memory_order_acquire);
+        if (!single) {
+            std::lock_guard<std::mutex> lock(mutex);
+            single = pointer.load(std::memory_order_relaxed);
+            if (!single) {
+                single = new T;
+                pointer.store(single, std::memory_order_release);
+            }
+        }
+        return *single;
+    }
+
+    static inline std::atomic<T*> pointer{nullptr};
+    static inline std::mutex mutex;
+};
+
+template <typename T>
+struct LockedEveryTime {
+    static T& instance() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!single) single = new T;
+        return *single;
+    }
+
+    static inline T* single = nullptr;
+    static inline std::mutex mutex;
+};
+
+// 1) "calls" calls of get() on each of "threads" threads, ns per call.
+template <typename Get>
+static double accessNs(unsigned threads, std::size_t calls, Get get) {
+    get();   // Constructed before the clock starts
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    volatile std::uintptr_t sink = 0;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            std::uintptr_t sum = 0;
+            for (std::size_t i = 0; i < calls; ++i) {
+                sum += reinterpret_cast<std::uintptr_t>(&get());
+                std::atomic_signal_fence(std::memory_order_seq_cst);   // No instruction: only keeps the compiler from hoisting get()
+            }
+            sink = sum;
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::thread& worker : workers) worker.join();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (double(calls) * threads);
+}
+
+// 2) A type per trial, so that every trial starts with a singleton nobody has touched yet.
+template <int Trial>
+struct SlowToBuild {
+    SlowToBuild() {
+        constructions.fetch_add(1, std::memory_order_relaxed);
+        auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(100);
+        while (std::chrono::steady_clock::now() < end) std::this_thread::yield();
+    }
+
+    static inline std::atomic<int> constructions{0};
+};
+
+struct Race {
+    double lastThreadUs = 0;   // From the release of the threads to the last one holding the instance
+    int constructions = 0;
+    bool sameObject = true;
+};
+
+template <template <typename> class Holder, int Trial>
+static Race firstTouch(unsigned threads) {
+    using T = SlowToBuild<Trial>;
+    std::atomic<unsigned> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<T*> seen(threads);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            seen[t] = &Holder<T>::instance();
+        });
+    }
+    while (ready.load() != threads) std::this_thread::yield();
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::thread& worker : workers) worker.join();
+
+    Race race;
+    race.lastThreadUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    race.constructions = T::constructions.load();
+    race.sameObject = std::all_of(seen.begin(), seen.end(), [&](T* p) { return p == seen[0]; });
+    return race;
+}
+
+template <template <typename> class Holder, int... Trials>
+static void firstTouches(const char* name, unsigned threads, std::integer_sequence<int, Trials...>) {
+    std::vector<Race> races = {firstTouch<Holder, Trials>(threads)...};
+    double totalUs = 0;
+    int worstConstructions = 0;
+    bool sameObject = true;
+    for (const Race& race : races) {
+        totalUs += race.lastThreadUs;
+        worstConstructions = std::max(worstConstructions, race.constructions);
+        sameObject = sameObject && race.sameObject;
+    }
+    std::printf("  %-24s %7.1f us   constructions per singleton: %d   same object everywhere: %s\n", name, totalUs / races.size(),
+                worstConstructions, sameObject ? "yes" : "NO");
+}
+
+// The trials of each holder get their own types (offsets), or the second holder would find them already built.
+template <int Offset, int... I>
+static constexpr std::integer_sequence<int, (Offset + I)...> offset(std::integer_sequence<int, I...>) { return {}; }
+
+int main() {
+    const std::size_t calls = 20000000;
+
+    SingleTon::instance();   // Its constructor prints a line
+    std::cout << "1) instance() once it exists, ns per call:" << std::endl;
+    std::printf("  threads                        1        2        4        8\n");
+    auto row = [&](const char* name, auto get) {
+        std::printf("  %-24s", name);
+        for (unsigned threads : {1u, 2u, 4u, 8u}) std::printf(" %8.2f", accessNs(threads, calls / threads, get));
+        std::printf("\n");
+    };
+    row("SingleTon::instance()", [] () -> SingleTon& { return SingleTon::instance(); });
+    row("function-local static", [] () -> Service& { return FunctionLocalStatic<Service>::instance(); });
+    row("double-checked atomic", [] () -> Service& { return DoubleChecked<Service>::instance(); });
+    row("mutex on every access", [] () -> Service& { return LockedEveryTime<Service>::instance(); });
+
+    std::cout << "2) first touch by 8 threads at once, 64 singletons each:" << std::endl;
+    constexpr auto trials = std::make_integer_sequence<int, 64>();
+    firstTouches<FunctionLocalStatic>("function-local static", 8, offset<0>(trials));
+    firstTouches<DoubleChecked>("double-checked atomic", 8, offset<64>(trials));
+    firstTouches<LockedEveryTime>("mutex on every access", 8, offset<128>(trials));
+
+    getchar();
+    return 0;
+}
@@ -11,72 +11,37 @@
 
 
 #include <iostream>
-#define ERROR_404 404
+#include <cstdio>
+#include <thread>
+#include <vector>
 
+#include "Singleton.hpp"  // Build with: g++ -std=c++20 Singleton.cpp -pthread
 
-class SingleTon {
-public:
-    SingleTon() : elem1(0), elem2(0) {
-        Instances++;
-        try {
-                if (Instances > 1) {
-                    std::cerr << "Error: Only one instance of SingleTon is allowed." << std::endl;
-                    throw ERROR_404;
-                } else {
-                    std::cout << "Instance created. Instances: " << Instances << std::endl;
-                }
-        } catch(const int) {
-                this-> ~SingleTon();
-                exit(69);
-        } 
-    }
-
-    ~SingleTon() {
-        std::cout << "Instance destroyed." << std::endl;
-        Instances--;
-    }
-
-    void Set_1(int val) {
-        this->elem1 = val;
-    }
 
-    void Set_2(int val) {
-        this->elem2 = val;
-    }
-
-    void Get_1() const {
-        std::cout << "elem1 = " << this->elem1 << std::endl;
-    }
-
-    void Get_2() const {
-        std::cout << "elem2 = " << this->elem2 << std::endl;
-    }
-
-    void Get_ctr() const {
-        std::cout << "Instances = " << Instances << std::endl;
-    }
-
-private:
-    int elem1;
-    int elem2;
-    static int Instances;
-};
-
-int SingleTon::Instances = 0;
+// The class used to be defined here, with a public constructor that counted the instances in a "static int" and called exit(69)
+// when a second one was created. It now lives in "Singleton.hpp": nobody can construct a second one, and SingleTon::instance()
+// creates the only one on first use, safely even when several threads ask for it at the same time.
 
 int main() {
-    SingleTon first;
+    SingleTon& first = SingleTon::instance();   // Instance created. Instances: 1
     first.Get_1();
     first.Get_2();
-    
-    std::cout<<"Before Exception"<<std::endl;
+
+    std::cout<<"Before the threads"<<std::endl;
     getchar();
-    
-    SingleTon second;  // This should fail due to the SingleTonton constraint ===> Code exits here with error code 69 as given
-    second.Get_1();
-    second.Get_2();
 
-    std::cout<<"After Exception"<<std::endl;
+    // "SingleTon second;" does not compile anymore (private constructor). Threads asking for it all get the same instance:
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([i] { SingleTon::instance().Set_1(i + 1); });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    SingleTon& second = SingleTon::instance();
+    second.Get_1();      // elem1 = the value of whichever thread set it last
+    second.Get_2();
+    second.Get_ctr();    // Instances = 1
+    std::cout<<"Same instance: "<<(&first == &second)<<std::endl;
 
     getchar();
     return 0;
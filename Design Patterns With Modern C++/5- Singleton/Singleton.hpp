@@ -0,0 +1,78 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief SingleTon: the class of "Singleton.cpp", made a real singleton.
+ *
+ *        The first version let anyone construct it, counted the instances in a plain "static int" (a data race as soon as two
+ *        threads construct one), and enforced the "only one" rule by calling exit(69) from the second constructor. Here:
+ *
+ *          - the constructor is private and copies are deleted: the only instance is SingleTon::instance(), there is no second one
+ *            to reject,
+ *          - instance() is a function-local static: built on first use (lazily), and C++11 guarantees that when several threads
+ *            get there first at the same time, exactly one constructs it and the others wait for it to finish. After that, an
+ *            access is one check of an already-set guard byte (an acquire load), no lock,
+ *          - the elements are atomics, so setting them from several threads is not a data race (and each Get sees a whole value),
+ *          - the instance count is an atomic, and stays at 1.
+ *
+ *            SingleTon::instance().Set_1(5);
+ *            SingleTon::instance().Get_1();    // elem1 = 5
+ *
+ *        "Singleton Benchmark.cpp" compares instance() with a double-checked atomic pointer and with a mutex taken on every access,
+ *        and races threads on the first access.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <iostream>
+
+
+class SingleTon {
+public:
+    static SingleTon& instance() {
+        static SingleTon single;   // Thread-safe initialization, once
+        return single;
+    }
+
+    SingleTon(const SingleTon&) = delete;
+    SingleTon& operator=(const SingleTon&) = delete;
+
+    void Set_1(int val) {
+        this->elem1.store(val, std::memory_order_relaxed);
+    }
+
+    void Set_2(int val) {
+        this->elem2.store(val, std::memory_order_relaxed);
+    }
+
+    void Get_1() const {
+        std::cout << "elem1 = " << this->elem1.load(std::memory_order_relaxed) << std::endl;
+    }
+
+    void Get_2() const {
+        std::cout << "elem2 = " << this->elem2.load(std::memory_order_relaxed) << std::endl;
+    }
+
+    void Get_ctr() const {
+        std::cout << "Instances = " << Instances.load() << std::endl;
+    }
+
+private:
+    SingleTon() : elem1(0), elem2(0) {
+        std::cout << "Instance created. Instances: " << ++Instances << std::endl;
+    }
+
+    ~SingleTon() {
+        std::cout << "Instance destroyed." << std::endl;
+        Instances--;
+    }
+
+    std::atomic<int> elem1;
+    std::atomic<int> elem2;
+    static inline std::atomic<int> Instances{0};
+};
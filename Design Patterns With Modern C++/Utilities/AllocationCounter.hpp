@@ -0,0 +1,53 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief AllocationCounter: counts every heap allocation of the program, for the benchmarks that report "allocations per object".
+ *
+ *        It replaces the global "operator new" (and the matching "operator delete") with malloc/free plus two relaxed atomic
+ *        counters, so it must be included by exactly one translation unit of a program: the benchmark's own .cpp.
+ *
+ *            const std::size_t before = AllocationCounter::allocations();
+ *            ...
+ *            double perCar = double(AllocationCounter::allocations() - before) / cars;
+ *
+ *        Over-aligned allocations ("operator new(size, std::align_val_t)") keep the library's versions and are not counted.
+ */
+
+#pragma once
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#include <cstddef>
+
+
+struct AllocationCounter {
+    static std::size_t allocations() { return allocations_.load(std::memory_order_relaxed); }
+    static std::size_t bytes() { return bytes_.load(std::memory_order_relaxed); }
+
+    static inline std::atomic<std::size_t> allocations_{0};
+    static inline std::atomic<std::size_t> bytes_{0};
+};
+
+void* operator new(std::size_t size) {
+    AllocationCounter::allocations_.fetch_add(1, std::memory_order_relaxed);
+    AllocationCounter::bytes_.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+// Once both are inlined, g++ sees the block of "new" reach free() and warns, although it came from malloc() above.
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,127 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief LatencyHistogram: records millions of latencies in a fixed amount of memory and answers percentiles (p50, p99, p999...).
+ *
+ *        Sorting a vector of every sample works for a short benchmark, not for a run of minutes. Like an HDR histogram, the buckets are
+ *        log-linear: each power of two is split into 128 equal buckets, so any value is known within 1/128 (< 0.8%) whether it is
+ *        a 200 ns hit or a 2 s stall, with about 7000 counters in total.
+ *
+ *        One histogram per thread (record() is not synchronized), merge() them when reporting.
+ *
+ *        Usage:
+ *            LatencyHistogram h;
+ *            h.record(elapsedNanoseconds);
+ *            h.percentile(99.9);      // Upper bound of the bucket holding the 99.9th percentile
+ *            h.text();                // "count=... mean=... p50=... p99=... p999=... max=..."
+ *            h.json();                // Same figures, plus the non-empty buckets
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+
+
+class LatencyHistogram {
+public:
+    static constexpr unsigned SubBucketBits = 7;
+    static constexpr std::uint64_t SubBuckets = std::uint64_t(1) << SubBucketBits;
+
+    LatencyHistogram() : counts_(bucketIndex(~std::uint64_t(0)) + 1, 0) {}
+
+    void record(std::uint64_t value, std::uint64_t times = 1) {
+        counts_[bucketIndex(value)] += times;
+        count_ += times;
+        sum_ += value * times;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    template <typename Rep, typename Period>
+    void record(std::chrono::duration<Rep, Period> elapsed) {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        record(ns < 0 ? 0 : static_cast<std::uint64_t>(ns));
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (std::size_t i = 0; i < counts_.size(); ++i) counts_[i] += other.counts_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    void reset() { *this = LatencyHistogram(); }
+
+    std::uint64_t count() const { return count_; }
+    std::uint64_t min() const { return count_ ? min_ : 0; }
+    std::uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    // Smallest bucket upper bound that at least "p" percent of the samples do not exceed (never above the real maximum).
+    std::uint64_t percentile(double p) const {
+        if (count_ == 0) return 0;
+        const double wanted = std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(count_);
+        const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(wanted + 0.5));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if (seen >= rank) return std::min(bucketUpper(i), max_);
+        }
+        return max_;
+    }
+
+    std::string text() const {
+        return "count=" + std::to_string(count_) + " mean=" + std::to_string(static_cast<std::uint64_t>(mean())) +
+               " min=" + std::to_string(min()) + " p50=" + std::to_string(percentile(50)) + " p90=" +
+               std::to_string(percentile(90)) + " p99=" + std::to_string(percentile(99)) + " p999=" +
+               std::to_string(percentile(99.9)) + " max=" + std::to_string(max_);
+    }
+
+    // {"count":..,"mean":..,"min":..,"p50":..,"p90":..,"p99":..,"p999":..,"max":..,"buckets":[[upper,count],...]}
+    std::string json() const {
+        std::string out = "{\"count\":" + std::to_string(count_) + ",\"mean\":" + std::to_string(mean()) +
+                          ",\"min\":" + std::to_string(min()) + ",\"p50\":" + std::to_string(percentile(50)) +
+                          ",\"p90\":" + std::to_string(percentile(90)) + ",\"p99\":" + std::to_string(percentile(99)) +
+                          ",\"p999\":" + std::to_string(percentile(99.9)) + ",\"max\":" + std::to_string(max_) + ",\"buckets\":[";
+        bool first = true;
+        for (std::size_t i = 0; i < counts_.size(); ++i) {
+            if (counts_[i] == 0) continue;
+            if (!first) out += ',';
+            first = false;
+            out += '[' + std::to_string(bucketUpper(i)) + ',' + std::to_string(counts_[i]) + ']';
+        }
+        return out + "]}";
+    }
+
+private:
+    // Values below 2^SubBucketBits have a bucket each, above that the top SubBucketBits + 1 bits choose the bucket.
+    static std::size_t bucketIndex(std::uint64_t value) {
+        if (value < SubBuckets) return static_cast<std::size_t>(value);
+        const unsigned magnitude = static_cast<unsigned>(std::bit_width(value)) - 1 - SubBucketBits;
+        return static_cast<std::size_t>(magnitude * SubBuckets + (value >> magnitude));
+    }
+
+    static std::uint64_t bucketUpper(std::size_t index) {
+        if (index < SubBuckets) return index;
+        const unsigned magnitude = static_cast<unsigned>(index / SubBuckets) - 1;
+        const std::uint64_t top = index - magnitude * SubBuckets;
+        return ((top + 1) << magnitude) - 1;
+    }
+
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t count_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t min_ = ~std::uint64_t(0);
+    std::uint64_t max_ = 0;
+};
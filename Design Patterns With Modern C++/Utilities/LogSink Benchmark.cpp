@@ -0,0 +1,65 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Messages per second through "LogSink" vs. "std::cout << ... << std::endl" with 1 to N threads.
+ *
+ *        Both write to stdout, so run it with stdout redirected and read the results on stderr:
+ *            g++ -std=c++20 -O2 -pthread "LogSink Benchmark.cpp" -o LogSinkBenchmark
+ *            ./LogSinkBenchmark > /dev/null
+ */
+
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+#include "LogSink.hpp"
+
+
+template <typename Body, typename Finish>
+static double messagesPerSecond(unsigned threads, int messagesPerThread, Body body, Finish finish) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([=] {
+            for (int i = 0; i < messagesPerThread; ++i) body(t, i);
+        });
+    }
+    for (auto& w : workers) w.join();
+    finish(); // Count the time it takes for the messages to actually reach the file
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return threads * static_cast<double>(messagesPerThread) / seconds;
+}
+
+int main() {
+    const int messagesPerThread = 200000;
+    const unsigned maxThreads = std::max(4u, std::thread::hardware_concurrency());
+
+    std::cerr << "threads | std::cout + std::endl (msg/s) | LogSink (msg/s)" << std::endl;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        double coutRate = messagesPerSecond(threads, messagesPerThread, [](unsigned t, int i) {
+            std::cout << "Printing job " << i << " on device " << t << std::endl;
+        }, [] {});
+
+        double sinkRate = 0;
+        {
+            LogSink sink;
+            sinkRate = messagesPerSecond(threads, messagesPerThread, [&sink](unsigned t, int i) {
+                sink.log("Printing job ", i, " on device ", t);
+            }, [&sink] { sink.flush(); });
+        }
+
+        std::cerr << threads << "       | " << coutRate << "                      | " << sinkRate << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,282 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief LogSink: a buffered replacement for "std::cout << ... << std::endl" in the examples.
+ *
+ *        "std::endl" flushes the stream on every message and "std::cout" is one shared stream, so when many threads print at the same time
+ *        every message pays for a lock and a system call. Here each thread appends its messages to its own lock-free ring buffer,
+ *        and a single background thread drains all the rings into the output file every "flushInterval" (or sooner when a ring fills up).
+ *
+ *        Usage:
+ *            logLine("Printing job ", 42, "...");      // Goes to the shared default sink (stdout)
+ *            defaultLogSink().flush();                  // Blocks until everything logged so far reached the file
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <charconv>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include <condition_variable>
+
+
+class LogSink {
+public:
+    struct Options {
+        std::FILE* out = stdout;
+        std::chrono::milliseconds flushInterval{10};   // Upper bound on how long a message may sit in a buffer
+        std::size_t bufferBytes = 64 * 1024;           // Per-thread ring size, rounded up to a power of two
+        bool dropWhenFull = false;                     // Drop messages instead of waiting for the writer when a ring is full
+    };
+
+    LogSink() : LogSink(Options{}) {}
+
+    explicit LogSink(Options options)
+        : options_(options), id_(nextSinkId().fetch_add(1, std::memory_order_relaxed)) {
+        std::size_t capacity = 1;
+        while (capacity < options_.bufferBytes) capacity <<= 1;
+        options_.bufferBytes = capacity;
+        writer_ = std::thread([this] { writerLoop(); });
+    }
+
+    ~LogSink() {
+        {
+            std::lock_guard<std::mutex> lock(writerMutex_);
+            stop_ = true;
+        }
+        writerCv_.notify_one();
+        writer_.join();
+    }
+
+    LogSink(const LogSink&) = delete;
+    LogSink& operator=(const LogSink&) = delete;
+
+    // Appends "message" followed by a new line, never takes a lock on the fast path. With "dropWhenFull", a message is dropped
+    // whole or written whole.
+    void write(std::string_view message) {
+        ThreadBuffer& buffer = localBuffer();
+        std::size_t needed = message.size() + 1;
+        if (needed > buffer.capacity) { // Larger than the whole ring: hand it over in pieces
+            // Only the first piece may be dropped: once it is in, the rest waits for the writer rather than cut the message.
+            bool mayDrop = options_.dropWhenFull;
+            while (!message.empty()) {
+                std::size_t piece = std::min(message.size(), buffer.capacity / 2);
+                if (!append(buffer, message.substr(0, piece), false, mayDrop)) return;
+                mayDrop = false;
+                message.remove_prefix(piece);
+            }
+            append(buffer, {}, true, false);
+            return;
+        }
+        append(buffer, message, true, options_.dropWhenFull);
+    }
+
+    // Formats strings, characters and numbers into a reusable per-thread string, then writes it.
+    template <typename... Args>
+    void log(const Args&... args) {
+        thread_local std::string scratch;
+        scratch.clear();
+        (appendField(scratch, args), ...);
+        write(scratch);
+    }
+
+    // Blocks until every message written before this call reached the output file.
+    void flush() {
+        std::unique_lock<std::mutex> lock(writerMutex_);
+        const std::uint64_t ticket = ++flushRequested_;
+        writerCv_.notify_one();
+        flushedCv_.wait(lock, [&] { return flushCompleted_ >= ticket; });
+    }
+
+    std::size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    // Single-producer (the owning thread) / single-consumer (the writer) byte ring.
+    struct ThreadBuffer {
+        explicit ThreadBuffer(std::size_t bytes) : capacity(bytes), data(new char[bytes]) {}
+
+        const std::size_t capacity;
+        std::unique_ptr<char[]> data;
+        alignas(64) std::atomic<std::uint64_t> head{0};   // Written by the owning thread
+        alignas(64) std::atomic<std::uint64_t> tail{0};   // Written by the writer thread
+        std::atomic<bool> retired{false};                // The owning thread exited
+    };
+
+    // Per-thread list of the buffers this thread owns in each sink. Weak: a destroyed sink frees its rings, and its entries are
+    // pruned the next time this thread registers a ring.
+    struct LocalBuffers {
+        std::vector<std::pair<std::uint64_t, std::weak_ptr<ThreadBuffer>>> buffers;
+        ~LocalBuffers() {
+            for (auto& entry : buffers) {
+                if (auto buffer = entry.second.lock()) buffer->retired.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    static std::atomic<std::uint64_t>& nextSinkId() {
+        static std::atomic<std::uint64_t> id{1};
+        return id;
+    }
+
+    ThreadBuffer& localBuffer() {
+        thread_local std::uint64_t cachedId = 0;
+        thread_local ThreadBuffer* cached = nullptr;
+        if (cachedId == id_) return *cached;
+
+        thread_local LocalBuffers local;
+        for (auto& entry : local.buffers) {
+            if (entry.first == id_) {   // This sink is alive (it is the caller), so is its ring
+                cachedId = id_;
+                cached = entry.second.lock().get();
+                return *cached;
+            }
+        }
+        local.buffers.erase(std::remove_if(local.buffers.begin(), local.buffers.end(), [](const auto& entry) { return entry.second.expired(); }),
+                            local.buffers.end());
+
+        // First message of this thread to this sink: register a new ring (the only locked step).
+        auto buffer = std::make_shared<ThreadBuffer>(options_.bufferBytes);
+        {
+            std::lock_guard<std::mutex> lock(registryMutex_);
+            registry_.push_back(buffer);
+        }
+        local.buffers.emplace_back(id_, buffer);
+        cachedId = id_;
+        cached = buffer.get();
+        return *cached;
+    }
+
+    // False if the bytes were dropped ("mayDrop" and no room), true once they are in the ring.
+    bool append(ThreadBuffer& buffer, std::string_view bytes, bool newLine, bool mayDrop) {
+        const std::size_t needed = bytes.size() + (newLine ? 1 : 0);
+        const std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+        while (buffer.capacity - (head - buffer.tail.load(std::memory_order_acquire)) < needed) {
+            if (mayDrop) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            wakeWriter();
+            std::this_thread::yield();
+        }
+
+        const std::size_t mask = buffer.capacity - 1;
+        const std::size_t start = head & mask;
+        const std::size_t first = std::min(bytes.size(), buffer.capacity - start);
+        std::copy_n(bytes.data(), first, buffer.data.get() + start);
+        std::copy_n(bytes.data() + first, bytes.size() - first, buffer.data.get());
+        if (newLine) buffer.data[(head + bytes.size()) & mask] = '\n';
+        buffer.head.store(head + needed, std::memory_order_release);
+        return true;
+    }
+
+    void wakeWriter() {
+        if (!urgent_.exchange(true, std::memory_order_acq_rel)) writerCv_.notify_one();
+    }
+
+    // Copies everything published so far in every ring to the file, returns false if there was nothing to write.
+    bool drainAll() {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex_);
+            buffers = registry_;
+        }
+
+        bool wrote = false;
+        for (auto& buffer : buffers) {
+            const bool retired = buffer->retired.load(std::memory_order_acquire);
+            const std::uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+            const std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+            if (head != tail) {
+                const std::size_t mask = buffer->capacity - 1;
+                const std::size_t start = tail & mask;
+                const std::size_t size = head - tail;
+                const std::size_t first = std::min(size, buffer->capacity - start);
+                std::fwrite(buffer->data.get() + start, 1, first, options_.out);
+                std::fwrite(buffer->data.get(), 1, size - first, options_.out);
+                buffer->tail.store(head, std::memory_order_release);
+                wrote = true;
+            }
+            if (retired) { // Nothing can be appended after retirement, so the ring is empty now
+                std::lock_guard<std::mutex> lock(registryMutex_);
+                registry_.erase(std::remove(registry_.begin(), registry_.end(), buffer), registry_.end());
+            }
+        }
+        if (wrote) std::fflush(options_.out);
+        return wrote;
+    }
+
+    void writerLoop() {
+        std::unique_lock<std::mutex> lock(writerMutex_);
+        for (;;) {
+            writerCv_.wait_for(lock, options_.flushInterval, [this] {
+                return stop_ || flushRequested_ != flushCompleted_ || urgent_.load(std::memory_order_acquire);
+            });
+            const bool stopping = stop_;
+            const std::uint64_t ticket = flushRequested_;
+            urgent_.store(false, std::memory_order_release);
+
+            lock.unlock();
+            drainAll();
+            lock.lock();
+
+            flushCompleted_ = ticket;
+            flushedCv_.notify_all();
+            if (stopping) return;
+        }
+    }
+
+    static void appendField(std::string& out, std::string_view text) { out.append(text); }
+    static void appendField(std::string& out, const std::string& text) { out.append(text); }
+    static void appendField(std::string& out, const char* text) { out.append(text); }
+    static void appendField(std::string& out, char c) { out.push_back(c); }
+    static void appendField(std::string& out, bool value) { out.append(value ? "true" : "false"); }
+
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>>
+    static void appendField(std::string& out, T value) {
+        char digits[64];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    }
+
+    Options options_;
+    const std::uint64_t id_;
+
+    std::mutex registryMutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> registry_;
+
+    std::mutex writerMutex_;
+    std::condition_variable writerCv_;
+    std::condition_variable flushedCv_;
+    std::uint64_t flushRequested_ = 0;
+    std::uint64_t flushCompleted_ = 0;
+    bool stop_ = false;
+    std::atomic<bool> urgent_{false};
+    std::atomic<std::size_t> dropped_{0};
+    std::thread writer_;
+};
+
+// Shared sink used by the examples, it writes to stdout and drains everything when the program exits.
+inline LogSink& defaultLogSink() {
+    static LogSink sink;
+    return sink;
+}
+
+template <typename... Args>
+void logLine(const Args&... args) {
+    defaultLogSink().log(args...);
+}
@@ -0,0 +1,112 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief Rcu: read-copy-update for data that is read all the time and changed rarely (a registry of types, a configuration).
+ *
+ *        The writer never changes what readers may be looking at. It builds a new version, publishes it with one atomic store, then
+ *        calls Rcu::synchronize() before destroying the old version: synchronize() returns once every reader that could still see
+ *        the old version has left its read section.
+ *
+ *            // Reader: no lock, no atomic read-modify-write, never waits for a writer.
+ *            {
+ *                Rcu::ReadGuard guard;
+ *                const Table* table = current.load(std::memory_order_acquire);
+ *                ... use *table ...
+ *            }
+ *
+ *            // Writer (writers are serialized by their own mutex):
+ *            const Table* old = current.exchange(new Table(...), std::memory_order_acq_rel);
+ *            Rcu::synchronize();
+ *            delete old;
+ *
+ *        Each thread that reads gets its own counter (a cache line), claimed from a list without a lock the first time and given
+ *        back when the thread exits: entering and leaving a read section are two stores to it, plus one fence so that the writer
+ *        cannot miss a reader that has already loaded the old pointer. Read sections nest. synchronize() must not be called inside
+ *        one (it would wait for itself), and it waits for the readers of every Rcu-protected structure, not only one.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <stdexcept>
+
+
+class Rcu {
+public:
+    class ReadGuard {
+    public:
+        ReadGuard() {
+            Reader& reader = localReader();
+            if (reader.depth++ == 0) {
+                Slot& slot = *reader.slot;
+                slot.state.store(slot.state.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);   // Odd: reading
+                std::atomic_thread_fence(std::memory_order_seq_cst);   // Announced before any protected pointer is loaded
+            }
+        }
+
+        ~ReadGuard() {
+            Reader& reader = localReader();
+            if (--reader.depth == 0) {
+                Slot& slot = *reader.slot;
+                slot.state.store(slot.state.load(std::memory_order_relaxed) + 1, std::memory_order_release);   // Even: done
+            }
+        }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+    };
+
+    // Waits until every read section that was running when it was called has ended.
+    static void synchronize() {
+        if (localReader().depth != 0) throw std::logic_error("Rcu::synchronize() called inside a read section");
+        std::atomic_thread_fence(std::memory_order_seq_cst);   // The caller's publication comes before the scan
+        for (Slot* slot = slots().load(std::memory_order_acquire); slot; slot = slot->next) {
+            const std::uint64_t state = slot->state.load(std::memory_order_acquire);
+            if (state % 2 == 0) continue;
+            while (slot->state.load(std::memory_order_acquire) == state) std::this_thread::yield();
+        }
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> state{0};   // Odd while its thread is inside a read section
+        std::atomic<bool> claimed{true};
+        Slot* next = nullptr;                  // Slots are never freed, only reused by later threads
+    };
+
+    struct Reader {
+        Slot* slot;
+        int depth = 0;
+
+        Reader() : slot(claimSlot()) {}
+        ~Reader() { slot->claimed.store(false, std::memory_order_release); }
+    };
+
+    static std::atomic<Slot*>& slots() {
+        static std::atomic<Slot*> head{nullptr};
+        return head;
+    }
+
+    static Slot* claimSlot() {
+        for (Slot* slot = slots().load(std::memory_order_acquire); slot; slot = slot->next) {
+            bool free = false;
+            if (!slot->claimed.load(std::memory_order_relaxed) && slot->claimed.compare_exchange_strong(free, true)) return slot;
+        }
+        Slot* slot = new Slot;
+        slot->next = slots().load(std::memory_order_relaxed);
+        while (!slots().compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed)) {}
+        return slot;
+    }
+
+    static Reader& localReader() {
+        thread_local Reader reader;
+        return reader;
+    }
+};
@@ -0,0 +1,197 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief ShardedValue<T>: a value many threads update and few read (a counter, a high-water mark), split into one slot per thread.
+ *
+ *        A single shared variable makes every update a write to the same cache line: with a mutex the threads queue for it, with
+ *        an atomic they still pass the line from core to core, and two unrelated variables next to each other do the same (false
+ *        sharing). Here each thread updates only its own slot, a cache line of its own, with a plain load and store: no lock, no
+ *        atomic read-modify-write, nothing another writer touches.
+ *
+ *        get() combines the slots with the merge function (sum by default, or max, min, or any T (*)(T, T)), starting from its
+ *        identity (0 for a sum, the lowest T for a max), which is also the value of a new slot:
+ *
+ *            ShardedValue<long> requests;                                   // Sum of the threads' shares
+ *            requests.add(1);                                              // On any thread, contention-free
+ *            long total = requests.get();
+ *
+ *            ShardedValue<int> peak(0, &ShardedValue<int>::max);           // Queue lengths are never below 0
+ *            peak.update([&](int mine) { return std::max(mine, queueLength); });
+ *
+ *        setMerge() changes the merge and its identity together, at any time: the slots keep their values.
+ *
+ *        get() combines each thread's latest value, not values taken at one instant: while threads are updating, it is one of the
+ *        results the updates could have given. A thread's slot is claimed on its first update (lock-free) and given back when it
+ *        exits, with its value: the next thread that claims it goes on from there, so a sum keeps the counts of exited threads.
+ *        Slots are only freed with the value (after the last thread that used it has exited, or has updated the value that reused
+ *        its id: a destroyed value's id goes to the next one, so each thread keeps an entry per value alive at once, not per value
+ *        ever created).
+ */
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <forward_list>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+
+template <typename T>
+class ShardedValue {
+public:
+    using Merge = T (*)(T, T);
+
+    static T sum(T a, T b) { return a + b; }
+    static T max(T a, T b) { return std::max(a, b); }
+    static T min(T a, T b) { return std::min(a, b); }
+
+    explicit ShardedValue(T identity = T(), Merge merge = &sum)
+        : shards_(std::make_shared<Shards>()), combine_(&shards_->combines.emplace_front(Combine{merge, identity})),
+          id_(ids().take()) {}
+
+    ~ShardedValue() { ids().give(id_); }
+
+    ShardedValue(const ShardedValue&) = delete;
+    ShardedValue& operator=(const ShardedValue&) = delete;
+
+    // Replaces the calling thread's share with f(share).
+    template <typename F>
+    void update(F&& f) {
+        Slot& slot = localSlot();
+        slot.value.store(f(slot.value.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+    }
+
+    void add(T delta) { update([delta](T value) { return value + delta; }); }
+    void set(T value) { update([value](T) { return value; }); }
+
+    T get() const {
+        const Combine& combine = *combine_.load(std::memory_order_acquire);
+        T result = combine.identity;
+        for (const Slot* slot = shards_->head.load(std::memory_order_acquire); slot; slot = slot->next) {
+            result = combine.merge(result, slot->value.load(std::memory_order_relaxed));
+        }
+        return result;
+    }
+
+    // "identity" is what merge(identity, x) leaves as x: get() starts from it, and a slot claimed from now on starts at it.
+    // Each call keeps the pair (a few bytes) until the value is destroyed: a get() may still be using the previous one.
+    void setMerge(Merge merge, T identity) {
+        std::lock_guard<std::mutex> lock(shards_->combinesMutex);
+        combine_.store(&shards_->combines.emplace_front(Combine{merge, identity}), std::memory_order_release);
+    }
+
+    // Slots created so far (the most threads that ever updated the value at once).
+    std::size_t shards() const {
+        std::size_t count = 0;
+        for (const Slot* slot = shards_->head.load(std::memory_order_acquire); slot; slot = slot->next) ++count;
+        return count;
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<T> value;                  // Written by the thread that claimed the slot only
+        std::atomic<bool> claimed{true};
+        Slot* next = nullptr;
+
+        explicit Slot(T initial) : value(initial) {}
+    };
+
+    // A merge and its identity, published together: never changed, never freed before the value.
+    struct Combine {
+        Merge merge;
+        T identity;
+    };
+
+    struct Shards {
+        std::atomic<Slot*> head{nullptr};
+        std::mutex combinesMutex;
+        std::forward_list<Combine> combines;   // Every pair set so far, the current one first
+
+        ~Shards() {
+            for (Slot* slot = head.load(std::memory_order_relaxed); slot;) delete std::exchange(slot, slot->next);
+        }
+
+        Slot* claim(T identity) {
+            for (Slot* slot = head.load(std::memory_order_acquire); slot; slot = slot->next) {
+                bool free = false;
+                if (!slot->claimed.load(std::memory_order_relaxed) && slot->claimed.compare_exchange_strong(free, true)) return slot;
+            }
+            Slot* slot = new Slot(identity);
+            slot->next = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed)) {}
+            return slot;
+        }
+    };
+
+    // The calling thread's slots, indexed by value id. Each keeps its Shards alive until the thread has given the slot back.
+    struct ThreadSlots {
+        struct Claimed {
+            std::shared_ptr<Shards> shards;
+            Slot* slot = nullptr;
+        };
+
+        std::vector<Claimed> byValue;
+
+        ~ThreadSlots() {
+            for (Claimed& claimed : byValue) {
+                if (claimed.slot) claimed.slot->claimed.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    // Value ids, smallest free one first so the threads' "byValue" stay short.
+    struct Ids {
+        std::mutex mutex;
+        std::vector<std::size_t> free;
+        std::size_t next = 0;
+
+        std::size_t take() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (free.empty()) return next++;
+            std::pop_heap(free.begin(), free.end(), std::greater<>());
+            const std::size_t id = free.back();
+            free.pop_back();
+            return id;
+        }
+
+        void give(std::size_t id) {
+            std::lock_guard<std::mutex> lock(mutex);
+            free.push_back(id);
+            std::push_heap(free.begin(), free.end(), std::greater<>());
+        }
+    };
+
+    // Never destroyed: a static ShardedValue may be destroyed after it.
+    static Ids& ids() {
+        static Ids* instance = new Ids;
+        return *instance;
+    }
+
+    Slot& localSlot() {
+        thread_local ThreadSlots slots;
+        if (id_ < slots.byValue.size()) {
+            typename ThreadSlots::Claimed& claimed = slots.byValue[id_];
+            if (claimed.shards == shards_) return *claimed.slot;
+            // Left by a destroyed value that had this id: give its slot back, which lets its Shards go
+            if (claimed.slot) claimed.slot->claimed.store(false, std::memory_order_release);
+        } else {
+            slots.byValue.resize(id_ + 1);
+        }
+        slots.byValue[id_] = {shards_, shards_->claim(combine_.load(std::memory_order_acquire)->identity)};
+        return *slots.byValue[id_].slot;
+    }
+
+    std::shared_ptr<Shards> shards_;
+    std::atomic<const Combine*> combine_;
+    const std::size_t id_;
+};
@@ -0,0 +1,90 @@
+/**
+ * \author Raouf Magdy (raoufma98@gmail.com)
+ *
+ * \date   18/10/2026
+ *
+*/
+
+/**
+ * \brief SymbolTable: string interning. Every distinct string gets a 32-bit id once, and from then on the id stands for the string.
+ *
+ *        When millions of objects hold strings from a tiny domain ("Toyota", "BMW", "Blue"...), each of them pays for a whole
+ *        std::string (32 bytes, plus a heap block past 15 characters) and every comparison walks characters. With interning each
+ *        distinct string is stored once, the objects hold 4-byte ids, and two symbols are equal exactly when their ids are.
+ *
+ *        - intern("Toyota") returns the id of "Toyota", adding it the first time. Id 0 is always the empty string.
+ *        - name(id) gives the string back. Symbols are never removed, so the std::string_view stays valid for the whole program.
+ *        - SymbolTable::global() is the table shared by the whole program.
+ *
+ *        Thread safety: thread-safe. Looking up an existing symbol or a name only takes a shared lock, adding a new one takes the
+ *        exclusive lock.
+ */
+
+#pragma once
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+
+class SymbolTable {
+public:
+    using Id = std::uint32_t;
+
+    SymbolTable() { intern(""); }
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    static SymbolTable& global() {
+        static SymbolTable table;
+        return table;
+    }
+
+    Id intern(std::string_view text) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = ids_.find(text);
+            if (it != ids_.end()) return it->second;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(text);   // Another thread may have added it meanwhile
+        if (it != ids_.end()) return it->second;
+        if (names_.size() > UINT32_MAX) throw std::length_error("SymbolTable: more than 2^32 symbols");
+
+        const Id id = static_cast<Id>(names_.size());
+        const std::string& stored = storage_.emplace_back(text);   // std::deque: never moves what it already holds
+        names_.push_back(stored);
+        ids_.emplace(stored, id);
+        return id;
+    }
+
+    std::string_view name(Id id) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return names_.at(id);
+    }
+
+    std::size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return names_.size();
+    }
+
+private:
+    struct NameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+    };
+
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> storage_;                                          // The characters, one copy per symbol
+    std::vector<std::string_view> names_;                                      // id -> name
+    std::unordered_map<std::string_view, Id, NameHash, std::equal_to<>> ids_;  // name -> id
+};